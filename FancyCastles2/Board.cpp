@@ -1,12 +1,153 @@
 #include <algorithm>
 #include <cassert>
-#include <ctime>
+#include <random>
+#include <thread>
 
 #include "Board.h"
+#include "GameSnapshot.h"
+#include "HexMath.h"
+#include "Random.h"
+#include "TileBitSet.h"
+
+namespace
+{
+	//below this many tiles it isn't worth starting threads to build the board
+	const int PARALLEL_MIN_TILES = 1 << 16;
+
+	//spread the low 32 bits of value out to the even bits of the result
+	std::uint64_t
+	SpreadBits(std::uint64_t value)
+	{
+		value &= 0x00000000ffffffffull;
+		value = (value | (value << 16)) & 0x0000ffff0000ffffull;
+		value = (value | (value << 8)) & 0x00ff00ff00ff00ffull;
+		value = (value | (value << 4)) & 0x0f0f0f0f0f0f0f0full;
+		value = (value | (value << 2)) & 0x3333333333333333ull;
+		value = (value | (value << 1)) & 0x5555555555555555ull;
+		return value;
+	}
+
+	//the shuffle splits the tiles into blocks of at most this size. The number of
+	// blocks only depends on the board size so a seed gives the same board on any machine
+	const int SHUFFLE_BLOCK_SIZE = 1 << 16;
+
+	//split [0, count) into contiguous chunks of at least minPerChunk and run func(begin, end) on each
+	template <typename Func>
+	void
+	ParallelFor(int count, int minPerChunk, Func func)
+	{
+		const int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+		const int numChunks = std::min(hardwareThreads, std::max(1, count / std::max(1, minPerChunk)));
+		if (numChunks <= 1)
+		{
+			func(0, count);
+			return;
+		}
+
+		std::vector<std::thread> workers;
+		workers.reserve(numChunks - 1);
+		for (int chunk = 1; chunk < numChunks; ++chunk)
+		{
+			const int begin = static_cast<int>(static_cast<long long>(count) * chunk / numChunks);
+			const int end = static_cast<int>(static_cast<long long>(count) * (chunk + 1) / numChunks);
+			workers.emplace_back(func, begin, end);
+		}
+
+		func(0, static_cast<int>(static_cast<long long>(count) / numChunks));
+
+		for (auto& worker : workers)
+			worker.join();
+	}
+
+	template <typename T>
+	void
+	FisherYatesShuffle(T* items, int numItems, CounterRandom& rng)
+	{
+		for (int i = numItems - 1; i > 0; --i)
+		{
+			const auto swapPos = static_cast<int>(rng.NextBelow(i + 1));
+			std::swap(items[i], items[swapPos]);
+		}
+	}
+
+	//merge two shuffled neighboring blocks into one shuffled block
+	// (MergeShuffle, Bacher, Bodini, Hollender and Lumbroso)
+	template <typename T>
+	void
+	MergeShuffledBlocks(T* items, int start, int mid, int end, CounterRandom& rng)
+	{
+		int i = start;
+		int j = mid;
+		for (;;)
+		{
+			if (rng.NextBit())
+			{
+				if (j == end)
+					break;
+				std::swap(items[i], items[j]);
+				++j;
+			}
+			else if (i == j)
+			{
+				break;
+			}
+			++i;
+		}
+
+		//one side ran out, fisher yates the rest of the items into place
+		for (; i < end; ++i)
+		{
+			const auto swapPos = start + static_cast<int>(rng.NextBelow(i - start + 1));
+			std::swap(items[i], items[swapPos]);
+		}
+	}
+
+	template <typename T>
+	void
+	MergeShuffle(T* items, int numItems, std::uint64_t seed)
+	{
+		int numBlocks = 1;
+		while (numItems / numBlocks > SHUFFLE_BLOCK_SIZE)
+			numBlocks *= 2;
+
+		auto blockStart = [numItems, numBlocks](int block)
+		{
+			return static_cast<int>(static_cast<long long>(numItems) * block / numBlocks);
+		};
+
+		//shuffle every block on its own, each with its own random stream
+		ParallelFor(numBlocks, 1, [&](int begin, int end)
+		{
+			for (int block = begin; block < end; ++block)
+			{
+				CounterRandom rng(seed, block);
+				FisherYatesShuffle(items + blockStart(block), blockStart(block + 1) - blockStart(block), rng);
+			}
+		});
+
+		//then merge pairs of blocks until there is only one left
+		std::uint64_t level = 1;
+		for (int width = 1; width < numBlocks; width *= 2, ++level)
+		{
+			const int numMerges = numBlocks / (2 * width);
+			ParallelFor(numMerges, 1, [&](int begin, int end)
+			{
+				for (int merge = begin; merge < end; ++merge)
+				{
+					const int firstBlock = merge * 2 * width;
+					CounterRandom rng(seed, (level << 32) | static_cast<std::uint64_t>(firstBlock));
+					MergeShuffledBlocks(items, blockStart(firstBlock), blockStart(firstBlock + width),
+						blockStart(firstBlock + 2 * width), rng);
+				}
+			});
+		}
+	}
+}
 
 Board::Board(): mNumTiles(0)
 	, mMapRadius(0)
-	, mBoard()
+	, mSeed(0)
+	, mOrdering(TileOrdering::COLUMNS)
 {
 }
 
@@ -28,80 +169,230 @@ Board::ComputeNextHexagonalNumber(int seed)
 
 void 
 Board::MakeBoard(int numTilesPerType)
+{
+	//no seed given, so every board should come out different
+	std::random_device entropy;
+	const auto seed = (static_cast<std::uint64_t>(entropy()) << 32) | entropy();
+	MakeBoard(numTilesPerType, seed);
+}
+
+void
+Board::MakeBoard(int numTilesPerType, std::uint64_t seed)
+{
+	MakeBoard(numTilesPerType, seed, TileOrdering::COLUMNS);
+}
+
+void
+Board::MakeBoard(int numTilesPerType, std::uint64_t seed, TileOrdering ordering)
 {
 	//make one of each type of tile for each player
 	//then add water tiles until there is enough to make the board a hex
 	const auto curNumTiles = static_cast<int>(ResourceType::NUMTYPES)*numTilesPerType;
 	mNumTiles = ComputeNextHexagonalNumber(curNumTiles);
-	mTiles.reserve(mNumTiles);
+	mSeed = seed;
+	mOrdering = ordering;
 
 	CreateTiles(numTilesPerType);
 	ShuffleTiles();
 	ArrangeTiles();
 }
 
+std::uint64_t
+Board::GetSeed() const
+{
+	return mSeed;
+}
+
+TileOrdering
+Board::GetTileOrdering() const
+{
+	return mOrdering;
+}
+
 void 
 Board::ShuffleTiles()
 {
-	srand(time(nullptr));
+	//the same seed always gives the same board, no matter how many threads did the work
+	MergeShuffle(mTileTypes.data(), mNumTiles, mSeed);
 
-	//fisher yates shuffle to randomize the tiles in the tile list
-	for (int i = mNumTiles - 1; i >= 0; --i)
-	{
-		auto swapPos = rand() % (i + 1);
-		mTiles[i].swap(mTiles[swapPos]);
-	}
+	//water can't be harvested, everything else starts at one
+	for (int tileIndex = 0; tileIndex < mNumTiles; ++tileIndex)
+		mHarvestRates[tileIndex] = static_cast<ResourceType>(mTileTypes[tileIndex]) == ResourceType::WATER ? 0 : 1;
 }
 
 void 
 Board::CreateTiles(int numTilesPerType)
 {
 	//make a tile for each type for each player and add it to the list of tiles
+	const int blockSize = TileBitSet::BITS_PER_WORD;
+	const int paddedNumTiles = (mNumTiles + blockSize - 1) / blockSize * blockSize;
+	mTileTypes.assign(paddedNumTiles, static_cast<std::uint8_t>(ResourceType::WATER));
+	mHarvestRates.assign(paddedNumTiles, 0);
+
+	int tileIndex = 0;
 	const int firstResourceType = static_cast<int>(ResourceType::WHEAT);
 	const int lastResourceType = static_cast<int>(ResourceType::WATER);
 	for (auto curType = firstResourceType; curType < lastResourceType; ++curType)
 	{
-		const auto curResource = static_cast<ResourceType>(curType);
 		for (int curTile = 0; curTile < numTilesPerType; ++curTile)
 		{
-			mTiles.emplace_back( std::make_unique<Tile>(curResource, mTiles.size()) );
+			mTileTypes[tileIndex++] = static_cast<std::uint8_t>(curType);
 		}
 	}
 
-	//the remaining tiles should be water
-	while (mTiles.size() < mNumTiles)
-	{
-		mTiles.emplace_back( std::make_unique<Tile>(ResourceType::WATER, mTiles.size()) );
-	}
-
-	assert(mNumTiles == mTiles.size());
+	//the remaining tiles should be water, which they already are
+	assert(tileIndex <= mNumTiles);
 }
 
 void 
 Board::ArrangeTiles()
 {
 	//Create the coordinates for the board to make a hexagonal
-	// shape and map them to the index of a tile in the tile list
+	// shape and map them to the index of a tile in the tile list.
+	//Tiles are numbered column by column in q, so remembering where
+	// each column starts is enough to go from a coord back to an index
+	const int numColumns = 2 * mMapRadius + 1;
+	mColumnOffsets.assign(numColumns, 0);
+
 	int tileIndex = 0;
 	for (int q = -mMapRadius; q <= mMapRadius; ++q)
 	{
-		const int r1 = std::max(-mMapRadius, -q - mMapRadius);
-		const int r2 = std::min(mMapRadius, -q + mMapRadius);
-		for (int r = r1; r <= r2; ++r)
+		mColumnOffsets[q + mMapRadius] = tileIndex;
+		tileIndex += numColumns - std::abs(q);
+	}
+
+	assert(tileIndex == mNumTiles);
+
+	//with the column starts known, the columns can be filled in independently
+	mTileCoords.assign(mNumTiles, AxialCoord());
+	ParallelFor(numColumns, PARALLEL_MIN_TILES / numColumns, [this](int begin, int end)
+	{
+		for (int column = begin; column < end; ++column)
 		{
-			AxialCoord curLocation(r, q);
-			mBoard[tileIndex] = curLocation;
-			mPosMap[curLocation] = tileIndex++;
+			const int q = column - mMapRadius;
+			const int r1 = std::max(-mMapRadius, -q - mMapRadius);
+			const int r2 = std::min(mMapRadius, -q + mMapRadius);
+
+			int tileIndex = mColumnOffsets[column];
+			for (int r = r1; r <= r2; ++r)
+				mTileCoords[tileIndex++] = AxialCoord(r, q);
 		}
+	});
+
+	//other orderings renumber the tiles and keep a table from column slot to tile ID
+	mColumnSlotToTile.clear();
+	if (mOrdering == TileOrdering::SPIRAL)
+		OrderTilesBySpiral();
+	else if (mOrdering == TileOrdering::MORTON)
+		OrderTilesByMorton();
+
+	if (mOrdering != TileOrdering::COLUMNS)
+	{
+		const auto columnIndex = GetIndexView();
+		mColumnSlotToTile.assign(mNumTiles, 0);
+		ParallelFor(mNumTiles, PARALLEL_MIN_TILES, [this, &columnIndex](int begin, int end)
+		{
+			for (int tileIndex = begin; tileIndex < end; ++tileIndex)
+				mColumnSlotToTile[columnIndex.GetColumnSlot(mTileCoords[tileIndex])] = tileIndex;
+		});
 	}
+
+	BuildNeighborTable();
+	BuildNeighborShiftRuns();
+}
+
+void
+Board::OrderTilesBySpiral()
+{
+	//tile 0 is the center, ring k starts right after the 3k(k-1)+1 tiles inside it
+	mTileCoords[0] = AxialCoord();
+	ParallelFor(mMapRadius, PARALLEL_MIN_TILES / std::max(1, 6 * mMapRadius), [this](int begin, int end)
+	{
+		for (int ring = begin + 1; ring <= end; ++ring)
+		{
+			int tileIndex = 3 * ring * (ring - 1) + 1;
+			auto position = HexMath::Direction(4) * ring;
+			for (const auto& direction : HexMath::DIRECTIONS)
+			{
+				for (int step = 0; step < ring; ++step)
+				{
+					mTileCoords[tileIndex++] = position;
+					position += direction;
+				}
+			}
+		}
+	});
+}
+
+void
+Board::OrderTilesByMorton()
+{
+	//sort the tiles along a z-order curve over (r, q) shifted to be non-negative
+	std::vector<std::pair<std::uint64_t, AxialCoord>> keyedCoords(mNumTiles);
+	ParallelFor(mNumTiles, PARALLEL_MIN_TILES, [this, &keyedCoords](int begin, int end)
+	{
+		for (int tileIndex = begin; tileIndex < end; ++tileIndex)
+		{
+			const auto& coord = mTileCoords[tileIndex];
+			const auto x = static_cast<std::uint64_t>(coord.r + mMapRadius);
+			const auto y = static_cast<std::uint64_t>(coord.q + mMapRadius);
+			keyedCoords[tileIndex] = std::make_pair(SpreadBits(x) | (SpreadBits(y) << 1), coord);
+		}
+	});
+
+	std::sort(keyedCoords.begin(), keyedCoords.end(),
+		[](const std::pair<std::uint64_t, AxialCoord>& lhs, const std::pair<std::uint64_t, AxialCoord>& rhs)
+	{
+		return lhs.first < rhs.first;
+	});
+
+	for (int tileIndex = 0; tileIndex < mNumTiles; ++tileIndex)
+		mTileCoords[tileIndex] = keyedCoords[tileIndex].second;
+}
+
+void
+Board::BuildNeighborTable()
+{
+	//every tile has at most six neighbors, only the ones on the edge of the board have fewer.
+	//count them first so each thread knows where its tiles' neighbors go
+	mNeighborOffsets.assign(mNumTiles + 1, 0);
+	ParallelFor(mNumTiles, PARALLEL_MIN_TILES, [this](int begin, int end)
+	{
+		for (int tileIndex = begin; tileIndex < end; ++tileIndex)
+		{
+			int numNeighbors = 0;
+			for (const auto& offset : HexMath::DIRECTIONS)
+			{
+				if (IsPositionValid(mTileCoords[tileIndex] + offset))
+					numNeighbors++;
+			}
+			mNeighborOffsets[tileIndex + 1] = numNeighbors;
+		}
+	});
+
+	for (int tileIndex = 0; tileIndex < mNumTiles; ++tileIndex)
+		mNeighborOffsets[tileIndex + 1] += mNeighborOffsets[tileIndex];
+
+	mNeighborIDs.assign(mNeighborOffsets[mNumTiles], 0);
+	ParallelFor(mNumTiles, PARALLEL_MIN_TILES, [this](int begin, int end)
+	{
+		for (int tileIndex = begin; tileIndex < end; ++tileIndex)
+		{
+			int neighborPos = mNeighborOffsets[tileIndex];
+			for (const auto& offset : HexMath::DIRECTIONS)
+			{
+				const auto neighbor = mTileCoords[tileIndex] + offset;
+				if (IsPositionValid(neighbor))
+					mNeighborIDs[neighborPos++] = GetTileIndex(neighbor);
+			}
+		}
+	});
 }
 
 bool 
 Board::IsPositionValid(const AxialCoord& position) const
 {
-	return !(abs(position.q) > mMapRadius ||
-			 abs(position.r) > mMapRadius ||
-			 abs(position.r + position.q) > mMapRadius);
+	return HexMath::IsInsideRadius(position, mMapRadius);
 }
 
 bool 
@@ -110,6 +401,70 @@ Board::IsTileValid(int tileID) const
 	return tileID >= 0 && tileID < mNumTiles;
 }
 
+void
+Board::BuildNeighborShiftRuns()
+{
+	//for each direction, group consecutive tiles whose neighbor in that
+	// direction is a constant number of IDs away. With tiles numbered
+	// column by column this gives roughly one run per column per direction.
+	//Directions are independent, so on big boards each gets its own thread
+	const int numDirections = HexMath::NUM_DIRECTIONS;
+	std::vector<TileShiftRunList> directionRuns(numDirections);
+	const int directionsPerThread = mNumTiles >= PARALLEL_MIN_TILES ? 1 : numDirections;
+	ParallelFor(numDirections, directionsPerThread, [this, &directionRuns](int begin, int end)
+	{
+		for (int direction = begin; direction < end; ++direction)
+		{
+			const auto& offset = HexMath::DIRECTIONS[direction];
+			auto& runs = directionRuns[direction];
+
+			TileShiftRun curRun = { 0, 0, 0 };
+			for (int tileIndex = 0; tileIndex < mNumTiles; ++tileIndex)
+			{
+				const auto neighbor = mTileCoords[tileIndex] + offset;
+				const bool hasNeighbor = IsPositionValid(neighbor);
+				const int delta = hasNeighbor ? GetTileIndex(neighbor) - tileIndex : 0;
+
+				const bool extendsRun = hasNeighbor && curRun.mLength > 0 &&
+					curRun.mDelta == delta && curRun.mStart + curRun.mLength == tileIndex;
+				if (extendsRun)
+				{
+					curRun.mLength++;
+					continue;
+				}
+
+				if (curRun.mLength > 0)
+					runs.push_back(curRun);
+
+				curRun.mStart = tileIndex;
+				curRun.mLength = hasNeighbor ? 1 : 0;
+				curRun.mDelta = delta;
+			}
+
+			if (curRun.mLength > 0)
+				runs.push_back(curRun);
+		}
+	});
+
+	mNeighborShiftRuns.clear();
+	for (const auto& runs : directionRuns)
+		mNeighborShiftRuns.insert(mNeighborShiftRuns.end(), runs.begin(), runs.end());
+}
+
+const TileShiftRunList&
+Board::GetNeighborShiftRuns() const
+{
+	return mNeighborShiftRuns;
+}
+
+TileIDRange
+Board::GetNeighbors(int tileID) const
+{
+	assert(IsTileValid(tileID));
+	const auto neighborData = mNeighborIDs.data();
+	return TileIDRange(neighborData + mNeighborOffsets[tileID], neighborData + mNeighborOffsets[tileID + 1]);
+}
+
 int
 Board::GetNumTiles() const
 {
@@ -119,34 +474,126 @@ Board::GetNumTiles() const
 AxialCoord 
 Board::GetTileCoord(int tileID) const
 {
-	const auto iter = mBoard.find(tileID);
-	assert(iter != mBoard.end());
-	return iter->second;
+	assert(IsTileValid(tileID));
+	return mTileCoords[tileID];
 }
 
 ResourceType 
 Board::GetTileType(int tileID) const
 {
-	return mTiles[tileID]->GetTileType();
+	return static_cast<ResourceType>(mTileTypes[tileID]);
 }
 
 int
 Board::GetTileIndex(const AxialCoord& coord) const
 {
-	const auto iter = mPosMap.find(coord);
-	assert(iter != mPosMap.end());
-	return iter->second;
+	assert(IsPositionValid(coord));
+	return GetIndexView().GetTileIndex(coord);
+}
+
+TileIndexView
+Board::GetIndexView() const
+{
+	//until a non-column ordering fills in the slot table, a column slot is the tile ID
+	return TileIndexView(mMapRadius, mColumnOffsets.data(),
+		mColumnSlotToTile.empty() ? nullptr : mColumnSlotToTile.data());
+}
+
+TileAreaRange
+Board::GetTilesInRange(const AxialCoord& center, int radius) const
+{
+	return TileAreaRange(GetIndexView(), center, radius);
+}
+
+TileRingRange
+Board::GetTilesInRing(const AxialCoord& center, int radius) const
+{
+	return TileRingRange(GetIndexView(), center, radius);
+}
+
+TileLineRange
+Board::GetTilesOnLine(const AxialCoord& from, const AxialCoord& to) const
+{
+	return TileLineRange(GetIndexView(), from, to);
 }
 
 int
 Board::GetHarvestRate(int tileID) const
 {
-	return mTiles[tileID]->GetHarvestRate();
+	return mHarvestRates[tileID];
 }
 
 void
 Board::SetHarvestRate(int tileID, int newRate)
 {
 	assert(tileID >= 0 && tileID < mNumTiles);
-	return mTiles[tileID]->SetHarvestRate(newRate);
-}
\ No newline at end of file
+	if (newRate <= 0)
+		return;
+
+	if (GetTileType(tileID) == ResourceType::WATER)
+		return;
+
+	mHarvestRates[tileID] = static_cast<std::int16_t>(std::min<int>(newRate, INT16_MAX));
+}
+
+Tile
+Board::GetTile(int tileID)
+{
+	assert(IsTileValid(tileID));
+	return Tile(*this, tileID);
+}
+
+ResourceTotals
+Board::GetHarvestTotals(const TileBitSet& tiles) const
+{
+	//total harvest rate per resource type over the tiles in the set.
+	//Each 64 tile block is masked and summed in straight-line loops over the
+	// columns, which the compiler turns into SIMD compares and adds
+	assert(tiles.GetNumTiles() == mNumTiles);
+	const int numTypes = static_cast<int>(ResourceType::NUMTYPES);
+	const int blockSize = TileBitSet::BITS_PER_WORD;
+
+	int typeTotals[static_cast<int>(ResourceType::NUMTYPES)] = {};
+	std::int16_t maskedRates[TileBitSet::BITS_PER_WORD];
+	for (int wordIndex = 0; wordIndex < tiles.GetNumWords(); ++wordIndex)
+	{
+		const auto word = tiles.GetWord(wordIndex);
+		if (word == 0)
+			continue;
+
+		const auto blockTypes = mTileTypes.data() + wordIndex * blockSize;
+		const auto blockRates = mHarvestRates.data() + wordIndex * blockSize;
+		for (int i = 0; i < blockSize; ++i)
+			maskedRates[i] = blockRates[i] & static_cast<std::int16_t>(-static_cast<int>((word >> i) & 1));
+
+		for (int type = 0; type < numTypes; ++type)
+		{
+			int typeTotal = 0;
+			for (int i = 0; i < blockSize; ++i)
+				typeTotal += blockTypes[i] == type ? maskedRates[i] : 0;
+			typeTotals[type] += typeTotal;
+		}
+	}
+
+	ResourceTotals totals;
+	std::copy(typeTotals, typeTotals + numTypes, totals.begin());
+	return totals;
+}
+
+void
+Board::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mNumTiles);
+	writer.WritePages(mTileTypes.data(), mTileTypes.size() * sizeof(mTileTypes[0]));
+	writer.WritePages(mHarvestRates.data(), mHarvestRates.size() * sizeof(mHarvestRates[0]));
+}
+
+void
+Board::LoadState(SnapshotReader& reader)
+{
+	int numTiles;
+	reader.Read(numTiles);
+	assert(numTiles == mNumTiles);
+	reader.ReadPages(mTileTypes.data(), mTileTypes.size() * sizeof(mTileTypes[0]));
+	reader.ReadPages(mHarvestRates.data(), mHarvestRates.size() * sizeof(mHarvestRates[0]));
+}
@@ -1,9 +1,34 @@
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <vector>
 
 #include "Tile.h"
+#include "TileRanges.h"
+
+class SnapshotReader;
+class SnapshotWriter;
+class TileBitSet;
+
+//a run of consecutive tile IDs whose neighbor in one hex direction is
+// always the tile mDelta IDs away, which lets a whole run be shifted at once
+struct TileShiftRun
+{
+	int mStart;
+	int mLength;
+	int mDelta;
+};
+
+using TileShiftRunList = std::vector < TileShiftRun > ;
+
+//how tile IDs are laid out over the board. Everything indexed by tile ID
+// (neighbor tables, tile sets, the renderer's buffers) follows this order
+enum class TileOrdering
+{
+	COLUMNS,	//column by column in q
+	SPIRAL,		//rings outward from the center
+	MORTON,		//z-order curve over the axial coordinates
+};
 
 class Board
 {
@@ -12,32 +37,78 @@ public:
 	Board();
 
 	void MakeBoard(int numTilesPerType);
+	void MakeBoard(int numTilesPerType, std::uint64_t seed);
+	void MakeBoard(int numTilesPerType, std::uint64_t seed, TileOrdering ordering);
+	std::uint64_t GetSeed() const;
+	TileOrdering GetTileOrdering() const;
 
 	AxialCoord  GetTileCoord(int tileID) const;
 	int GetTileIndex(const AxialCoord& coord) const;
 	bool IsPositionValid(const AxialCoord& position) const;
 	bool IsTileValid(int tileID) const;
+	TileIDRange GetNeighbors(int tileID) const;
+	const TileShiftRunList& GetNeighborShiftRuns() const;
+
+	TileIndexView GetIndexView() const;
+	TileAreaRange GetTilesInRange(const AxialCoord& center, int radius) const;
+	TileRingRange GetTilesInRing(const AxialCoord& center, int radius) const;
+	TileLineRange GetTilesOnLine(const AxialCoord& from, const AxialCoord& to) const;
 
 	int GetNumTiles() const;
+	Tile GetTile(int tileID);
 	ResourceType GetTileType(int tileID) const;
 	int GetHarvestRate(int tileID) const;
 	void SetHarvestRate(int tileID, int newRate);
 
+	ResourceTotals GetHarvestTotals(const TileBitSet& tiles) const;
+
+	//the tile columns, as pages. The layout and neighbors never change once the
+	// board is made, so a snapshot can only go back onto the board it came from
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
 private:
-	using TileCoordMap = std::unordered_map<int, AxialCoord>;
-	using TileIDMap = std::unordered_map<AxialCoord, int >;
-	using TileList = std::vector < std::unique_ptr<Tile> > ;
+	using TileCoordList = std::vector < AxialCoord > ;
+	using ColumnOffsetList = std::vector < int > ;
+	using ColumnSlotList = std::vector < int > ;
+	using NeighborOffsetList = std::vector < int > ;
+	using NeighborIDList = std::vector < int > ;
+	using TileTypeList = std::vector < std::uint8_t > ;
+	using HarvestRateList = std::vector < std::int16_t > ;
 
 	void CreateTiles(int numTilesPerType);
 	void ShuffleTiles();
 	void ArrangeTiles();
+	void OrderTilesBySpiral();
+	void OrderTilesByMorton();
+	void BuildNeighborTable();
+	void BuildNeighborShiftRuns();
 
 	int ComputeNextHexagonalNumber(int seed);
 
 	int mNumTiles;
 	int mMapRadius;
+	std::uint64_t mSeed;
+	TileOrdering mOrdering;
+
+	//index -> coord is a flat lookup, coord -> index is the start of the
+	// tile's q column plus its offset down that column. When tiles aren't
+	// ordered by column, that column slot is mapped to the tile ID
+	TileCoordList mTileCoords;
+	ColumnOffsetList mColumnOffsets;
+	ColumnSlotList mColumnSlotToTile;
+
+	//compressed sparse row adjacency: the neighbors of tile i are
+	// mNeighborIDs[mNeighborOffsets[i]] up to mNeighborIDs[mNeighborOffsets[i+1]]
+	NeighborOffsetList mNeighborOffsets;
+	NeighborIDList mNeighborIDs;
+
+	//the same adjacency grouped into runs for all six directions
+	TileShiftRunList mNeighborShiftRuns;
 
-	TileCoordMap mBoard;
-	TileList mTiles;
-	TileIDMap mPosMap;
+	//tile properties stored as one column per property, indexed by tile ID.
+	//The columns are padded with water out to a multiple of 64 tiles so bulk
+	// queries can always work a whole tile set word at a time
+	TileTypeList mTileTypes;
+	HarvestRateList mHarvestRates;
 };
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "BoardChunks.h"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+namespace
+{
+	//floor division, so the chunk boundaries line up on both sides of 0
+	int
+	GetChunkIndex(int coord)
+	{
+		return coord >= 0 ? coord / BoardChunks::CHUNK_SIZE : -((-coord + BoardChunks::CHUNK_SIZE - 1) / BoardChunks::CHUNK_SIZE);
+	}
+}
+
+BoardChunks::BoardChunks()
+{
+}
+
+BoardChunks::BoardChunks(const std::vector<AxialCoord>& tileCoords)
+{
+	//sort the tiles by chunk, tile ID breaks ties so the order is stable
+	using ChunkedTile = std::tuple < int, int, int > ;
+	std::vector<ChunkedTile> chunkedTiles;
+	chunkedTiles.reserve(tileCoords.size());
+	for (int tileID = 0; tileID < static_cast<int>(tileCoords.size()); ++tileID)
+		chunkedTiles.emplace_back(GetChunkIndex(tileCoords[tileID].q), GetChunkIndex(tileCoords[tileID].r), tileID);
+
+	std::sort(chunkedTiles.begin(), chunkedTiles.end());
+
+	mTileToSlot.assign(tileCoords.size(), 0);
+	mSlotToTile.assign(tileCoords.size(), 0);
+	for (int slot = 0; slot < static_cast<int>(chunkedTiles.size()); ++slot)
+	{
+		const auto tileID = std::get<2>(chunkedTiles[slot]);
+		mTileToSlot[tileID] = slot;
+		mSlotToTile[slot] = tileID;
+
+		const bool newChunk = slot == 0 ||
+			std::get<0>(chunkedTiles[slot]) != std::get<0>(chunkedTiles[slot - 1]) ||
+			std::get<1>(chunkedTiles[slot]) != std::get<1>(chunkedTiles[slot - 1]);
+		if (newChunk)
+		{
+			BoardChunk chunk;
+			chunk.mFirstSlot = slot;
+			chunk.mNumTiles = 0;
+			mChunks.push_back(chunk);
+		}
+
+		//a hex reaches HEX_SIZE out from its center at the corners
+		float x, y;
+		HexLayout::GetCartesianFromAxial(x, y, tileCoords[tileID]);
+		auto& chunk = mChunks.back();
+		chunk.mBounds.Add(x - HexLayout::HEX_SIZE, y - HexLayout::HEX_SIZE);
+		chunk.mBounds.Add(x + HexLayout::HEX_SIZE, y + HexLayout::HEX_SIZE);
+		chunk.mNumTiles++;
+	}
+}
+
+int
+BoardChunks::GetNumChunks() const
+{
+	return static_cast<int>(mChunks.size());
+}
+
+const BoardChunk&
+BoardChunks::GetChunk(int chunkIndex) const
+{
+	assert(chunkIndex >= 0 && chunkIndex < GetNumChunks());
+	return mChunks[chunkIndex];
+}
+
+int
+BoardChunks::GetTileSlot(int tileID) const
+{
+	return mTileToSlot[tileID];
+}
+
+int
+BoardChunks::GetSlotTile(int slot) const
+{
+	return mSlotToTile[slot];
+}
+
+int
+BoardChunks::GetSlotChunk(int slot) const
+{
+	assert(slot >= 0 && slot < static_cast<int>(mSlotToTile.size()));
+	const auto chunk = std::upper_bound(mChunks.begin(), mChunks.end(), slot,
+		[](int slot, const BoardChunk& chunk) { return slot < chunk.mFirstSlot; });
+	return static_cast<int>(chunk - mChunks.begin()) - 1;
+}
+
+void
+BoardChunks::FindVisibleSlots(const HexLayout::WorldRect& view, TileSlotRangeList& ranges) const
+{
+	ranges.clear();
+	for (const auto& chunk : mChunks)
+	{
+		if (!chunk.mBounds.Intersects(view))
+			continue;
+
+		const int end = chunk.mFirstSlot + chunk.mNumTiles;
+		if (!ranges.empty() && ranges.back().mEnd == chunk.mFirstSlot)
+			ranges.back().mEnd = end;
+		else
+			ranges.push_back({ chunk.mFirstSlot, end });
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+#include "HexLayout.h"
+#include "TileTraits.h"
+
+//a run of draw slots [mBegin, mEnd)
+struct TileSlotRange
+{
+	int mBegin;
+	int mEnd;
+};
+
+using TileSlotRangeList = std::vector < TileSlotRange > ;
+
+//a block of neighboring tiles that gets culled as one
+struct BoardChunk
+{
+	HexLayout::WorldRect mBounds;	//covers every hex in the chunk, not just the centers
+	int mFirstSlot;
+	int mNumTiles;
+};
+
+//Splits the board into CHUNK_SIZE x CHUNK_SIZE blocks of axial coords and gives
+// every tile a draw slot, numbered so each chunk's tiles are contiguous.
+//Drawing only the chunks that touch the view keeps the cost of a frame in line
+// with what's on screen instead of with the size of the board
+class BoardChunks
+{
+public:
+	static const int CHUNK_SIZE = 16;
+
+	BoardChunks();
+
+	//tileCoords[tileID] is the tile's position on the board
+	explicit BoardChunks(const std::vector<AxialCoord>& tileCoords);
+
+	int GetNumChunks() const;
+	const BoardChunk& GetChunk(int chunkIndex) const;
+
+	int GetTileSlot(int tileID) const;
+	int GetSlotTile(int slot) const;
+
+	//index of the chunk the slot belongs to
+	int GetSlotChunk(int slot) const;
+
+	//fills ranges with the slots of every chunk whose bounds touch the view,
+	// in increasing order with neighboring chunks merged into one range
+	void FindVisibleSlots(const HexLayout::WorldRect& view, TileSlotRangeList& ranges) const;
+
+private:
+	std::vector<BoardChunk> mChunks;
+	std::vector<int> mTileToSlot;
+	std::vector<int> mSlotToTile;
+};
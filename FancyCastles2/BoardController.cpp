@@ -1,8 +1,12 @@
 #include "BoardController.h"
 
-#include <queue>
+#include <algorithm>
+#include <functional>
+#include <utility>
 
 #include "Board.h"
+#include "GameSnapshot.h"
+#include "HexMath.h"
 
 BoardController::BoardController(BoardPtr board) : mBoard(std::move(board))
 {
@@ -72,68 +76,263 @@ BoardController::GetTileType(int tileID) const
 	return ResourceType::INVALID;
 }
 
-const std::vector<AxialCoord> adjacentOffsets =
+ResourceTotals
+BoardController::GetHarvestTotals(const TileIDSet& tiles) const
 {
-	{ -1, 0 }, { -1, 1 }, { 0, -1 },
-	{ 1, 0 }, { 1, -1 }, { 0, 1 }
-};
+	return GetHarvestTotals(TileBitSet(GetNumTiles(), tiles));
+}
+
+ResourceTotals
+BoardController::GetHarvestTotals(const TileBitSet& tiles) const
+{
+	return mBoard->GetHarvestTotals(tiles);
+}
+
+TileIDRange
+BoardController::GetNeighbors(int tileID) const
+{
+	if (mBoard->IsTileValid(tileID))
+		return mBoard->GetNeighbors(tileID);
+
+	return TileIDRange();
+}
 
 TileIDSet
 BoardController::FindNeighbors(int tileID) const
 {
-	TileIDSet neighbors;
+	const auto neighbors = GetNeighbors(tileID);
+	return TileIDSet(neighbors.begin(), neighbors.end());
+}
 
-	const auto position = mBoard->GetTileCoord(tileID);
-	for (auto& offset : adjacentOffsets)
+TileAreaRange
+BoardController::GetTilesInRange(int tileID, int radius) const
+{
+	if (mBoard->IsTileValid(tileID))
+		return mBoard->GetTilesInRange(mBoard->GetTileCoord(tileID), radius);
+
+	return TileAreaRange();
+}
+
+TileRingRange
+BoardController::GetTilesInRing(int tileID, int radius) const
+{
+	if (mBoard->IsTileValid(tileID))
+		return mBoard->GetTilesInRing(mBoard->GetTileCoord(tileID), radius);
+
+	return TileRingRange();
+}
+
+TileLineRange
+BoardController::GetTilesOnLine(int sourceID, int targetID) const
+{
+	if (mBoard->IsTileValid(sourceID) && mBoard->IsTileValid(targetID))
+		return mBoard->GetTilesOnLine(mBoard->GetTileCoord(sourceID), mBoard->GetTileCoord(targetID));
+
+	return TileLineRange();
+}
+
+bool
+BoardController::HasLineOfSight(int sourceID, int targetID, ResourceTypeMask blockingTypes) const
+{
+	//the tiles at either end never block, only the ones in between
+	if (!mBoard->IsTileValid(sourceID) || !mBoard->IsTileValid(targetID))
+		return false;
+
+	const auto line = GetTilesOnLine(sourceID, targetID);
+	for (auto iter = line.begin(); iter != line.end(); ++iter)
 	{
-		AxialCoord neighbor = position + offset;
-		if (mBoard->IsPositionValid(neighbor))
-			neighbors.insert(mBoard->GetTileIndex(neighbor));
+		if (iter.IsEndpoint())
+			continue;
+
+		if (ToResourceTypeMask(mBoard->GetTileType(*iter)) & blockingTypes)
+			return false;
 	}
 
-	return neighbors;
+	return true;
 }
 
 TileIDList
 BoardController::FindConnectedPath(const TileIDSet& tiles, int source, int target) const
 {
 	TileIDList path;
-
+	FindConnectedPath(TileBitSet(GetNumTiles(), tiles), source, target, path);
 	return path;
 }
 
-TileIDSet
-BoardController::FindConnectedComponent(const TileIDSet& tiles, int source) const
+int
+BoardController::GetPathHeuristic(int tileID, const AxialCoord& target) const
 {
-	TileIDSet connectedComponent;
-	std::queue<int> tileIDsToVisit;
+	//number of steps between the two tiles on an open board
+	return HexMath::Distance(mBoard->GetTileCoord(tileID), target);
+}
 
-	//make sure the source tile is in the set we are searching
-	if (tiles.count(source) > 0)
+bool
+BoardController::FindConnectedPath(const TileBitSet& tiles, int source, int target, TileIDList& path) const
+{
+	//A* restricted to the tiles in the set, path is filled in from source to target inclusive
+	path.clear();
+	if (!tiles.Test(source) || !tiles.Test(target))
+		return false;
+
+	auto& scratch = mPathScratch;
+	const auto numTiles = static_cast<size_t>(GetNumTiles());
+	if (scratch.mVisitedStamp.size() != numTiles)
+	{
+		scratch.mCameFrom.assign(numTiles, -1);
+		scratch.mCostSoFar.assign(numTiles, 0);
+		scratch.mVisitedStamp.assign(numTiles, 0);
+		scratch.mGeneration = 0;
+	}
+
+	//bumping the generation invalidates everything from the last search,
+	// only clear the stamps when the counter wraps around
+	if (++scratch.mGeneration == 0)
 	{
-		connectedComponent.insert(source);
-		tileIDsToVisit.push(source);
+		std::fill(scratch.mVisitedStamp.begin(), scratch.mVisitedStamp.end(), 0);
+		scratch.mGeneration = 1;
 	}
+	const auto generation = scratch.mGeneration;
+
+	const auto targetCoord = mBoard->GetTileCoord(target);
+	const auto heapOrder = std::greater<PathScratch::OpenEntry>();
+	auto& openHeap = scratch.mOpenHeap;
+	openHeap.clear();
+
+	scratch.mVisitedStamp[source] = generation;
+	scratch.mCameFrom[source] = -1;
+	scratch.mCostSoFar[source] = 0;
+	openHeap.emplace_back(GetPathHeuristic(source, targetCoord), source);
 
-	while (!tileIDsToVisit.empty())
+	bool foundTarget = false;
+	while (!openHeap.empty())
 	{
-		const auto curTileID = tileIDsToVisit.front();
-		tileIDsToVisit.pop();
+		std::pop_heap(openHeap.begin(), openHeap.end(), heapOrder);
+		const auto curEntry = openHeap.back();
+		openHeap.pop_back();
 
-		for (auto neighbor : FindNeighbors(curTileID))
+		const auto curTileID = curEntry.second;
+		if (curTileID == target)
 		{
-			//only add neighboring tiles that belong to the set we care about and haven't seen yet
-			if (tiles.count(neighbor) > 0 && connectedComponent.count(neighbor) == 0)
-			{
-				connectedComponent.insert(neighbor);
-				tileIDsToVisit.push(neighbor);
-
-				//stop looking if we found all tiles in the set
-				if (connectedComponent.size() == tiles.size())
-					return connectedComponent;
-			}
+			foundTarget = true;
+			break;
+		}
+
+		//skip stale heap entries for tiles that were reached more cheaply since they were pushed
+		const auto curCost = scratch.mCostSoFar[curTileID];
+		if (curEntry.first > curCost + GetPathHeuristic(curTileID, targetCoord))
+			continue;
+
+		for (auto neighbor : mBoard->GetNeighbors(curTileID))
+		{
+			if (!tiles.Test(neighbor))
+				continue;
+
+			const auto newCost = curCost + 1;
+			const bool seen = scratch.mVisitedStamp[neighbor] == generation;
+			if (seen && scratch.mCostSoFar[neighbor] <= newCost)
+				continue;
+
+			scratch.mVisitedStamp[neighbor] = generation;
+			scratch.mCostSoFar[neighbor] = newCost;
+			scratch.mCameFrom[neighbor] = curTileID;
+
+			openHeap.emplace_back(newCost + GetPathHeuristic(neighbor, targetCoord), neighbor);
+			std::push_heap(openHeap.begin(), openHeap.end(), heapOrder);
 		}
 	}
 
+	if (!foundTarget)
+		return false;
+
+	for (int tileID = target; tileID != -1; tileID = scratch.mCameFrom[tileID])
+		path.push_back(tileID);
+
+	std::reverse(path.begin(), path.end());
+	return true;
+}
+
+void
+BoardController::FindConnectedPaths(const TileBitSet& tiles, const TilePathQueryList& queries, TilePathList& paths) const
+{
+	//answer every query against the same tile set, reusing the caller's path storage
+	paths.resize(queries.size());
+	for (size_t i = 0; i < queries.size(); ++i)
+		FindConnectedPath(tiles, queries[i].first, queries[i].second, paths[i]);
+}
+
+TileIDSet
+BoardController::FindConnectedComponent(const TileIDSet& tiles, int source) const
+{
+	const TileBitSet tileBits(GetNumTiles(), tiles);
+	return FindConnectedComponent(tileBits, source).ToTileIDSet();
+}
+
+TileBitSet
+BoardController::FindConnectedComponent(const TileBitSet& tiles, int source) const
+{
+	TileBitSet connectedComponent(GetNumTiles());
+
+	//make sure the source tile is in the set we are searching
+	if (!tiles.Test(source))
+		return connectedComponent;
+
+	connectedComponent.Set(source);
+
+	//flood fill: grow the newest ring of tiles by one step in every direction,
+	// keep the part that belongs to the set and hasn't been seen yet
+	TileBitSet frontier = connectedComponent;
+	TileBitSet grown(GetNumTiles());
+	while (frontier.Any())
+	{
+		DilateTiles(frontier, grown);
+		grown &= tiles;
+		grown -= connectedComponent;
+
+		connectedComponent |= grown;
+		std::swap(frontier, grown);
+	}
+
 	return connectedComponent;
-}
\ No newline at end of file
+}
+
+void
+BoardController::DilateTiles(const TileBitSet& tiles, TileBitSet& dilated) const
+{
+	dilated.Clear();
+	for (const auto& run : mBoard->GetNeighborShiftRuns())
+		dilated.OrShiftedRange(tiles, run.mStart, run.mLength, run.mDelta);
+}
+
+int
+BoardController::GetNumTiles() const
+{
+	return mBoard->GetNumTiles();
+}
+
+void
+BoardController::SaveState(SnapshotWriter& writer) const
+{
+	mBoard->SaveState(writer);
+
+	//player ID, tile ID pairs
+	std::vector<int> selections;
+	selections.reserve(2 * mPlayerSelectionsMap.size());
+	for (const auto& selection : mPlayerSelectionsMap)
+	{
+		selections.push_back(selection.first);
+		selections.push_back(selection.second);
+	}
+	writer.WriteVector(selections);
+}
+
+void
+BoardController::LoadState(SnapshotReader& reader)
+{
+	mBoard->LoadState(reader);
+
+	std::vector<int> selections;
+	reader.ReadVector(selections);
+	mPlayerSelectionsMap.clear();
+	for (size_t i = 0; i + 1 < selections.size(); i += 2)
+		mPlayerSelectionsMap[selections[i]] = selections[i + 1];
+}
@@ -2,14 +2,23 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "TileBitSet.h"
+#include "TileRanges.h"
 #include "TileTraits.h"
 
 class Board;
+class SnapshotReader;
+class SnapshotWriter;
 
 using BoardPtr = std::unique_ptr < Board > ;
 using TileIDList = std::vector < int > ;
 using TileIDSet = std::unordered_set < int > ;
+using TilePathQuery = std::pair < int, int > ;
+using TilePathQueryList = std::vector < TilePathQuery > ;
+using TilePathList = std::vector < TileIDList > ;
 
 class BoardController
 {
@@ -29,14 +38,49 @@ public:
 
 	int GetHarvestRate(int tileID) const;
 	ResourceType GetTileType(int tileID) const;
+	ResourceTotals GetHarvestTotals(const TileIDSet& tiles) const;
+	ResourceTotals GetHarvestTotals(const TileBitSet& tiles) const;
 
+	TileIDRange GetNeighbors(int tileID) const;
 	TileIDSet FindNeighbors(int tileID) const;
+	TileAreaRange GetTilesInRange(int tileID, int radius) const;
+	TileRingRange GetTilesInRing(int tileID, int radius) const;
+	TileLineRange GetTilesOnLine(int sourceID, int targetID) const;
+	bool HasLineOfSight(int sourceID, int targetID, ResourceTypeMask blockingTypes) const;
 	TileIDSet FindConnectedComponent(const TileIDSet& tiles, int source) const;
+	TileBitSet FindConnectedComponent(const TileBitSet& tiles, int source) const;
 	TileIDList FindConnectedPath(const TileIDSet& tiles, int source, int target) const;
+	bool FindConnectedPath(const TileBitSet& tiles, int source, int target, TileIDList& path) const;
+	void FindConnectedPaths(const TileBitSet& tiles, const TilePathQueryList& queries, TilePathList& paths) const;
+
+	int GetNumTiles() const;
+
+	//the board's tiles and every player's selection
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
 
 private:
+	void DilateTiles(const TileBitSet& tiles, TileBitSet& dilated) const;
+	int GetPathHeuristic(int tileID, const AxialCoord& target) const;
+
+	//buffers reused by every path search so a query doesn't allocate once they've grown.
+	//a tile's entries are only meaningful when its stamp matches the current generation
+	struct PathScratch
+	{
+		using OpenEntry = std::pair < int, int > ; //estimated total cost, tile ID
+
+		std::vector<OpenEntry> mOpenHeap;
+		std::vector<int> mCameFrom;
+		std::vector<int> mCostSoFar;
+		std::vector<unsigned int> mVisitedStamp;
+		unsigned int mGeneration;
+
+		PathScratch() : mGeneration(0) { }
+	};
 
 	BoardPtr mBoard;
 
 	std::unordered_map<int, int> mPlayerSelectionsMap;
+
+	mutable PathScratch mPathScratch;
 };
\ No newline at end of file
@@ -1,64 +1,39 @@
 #pragma once
 
-#include <GLFW/glfw3.h>
-#include <glm.hpp>
-#include <vector>
-#include <unordered_map>
-
+#include "FramePacer.h"
 #include "TileTraits.h"
 
 class Board;
 
+//What the game needs from whatever draws the board. GLBoardRenderer draws to a
+// window with OpenGL, SoftwareBoardRenderer draws into an image in memory for
+// hosts without a GPU or a display
 class BoardRenderer
 {
-
 public:
-	BoardRenderer(GLFWwindow*, int, int);
-	void Init();
-
-	void SetupTiles(const Board& gameBoard);
-	void SetSelection(const AxialCoord& position);
-
-	int DoPick();
-	void RenderScene();
-
-	void Cleanup();
-
-private:
-	void SetupHexVerts(const std::vector<AxialCoord>& tileCoords);
-	void SetupTileColors(const std::vector<Color>& tileColors);
-	void SetupBuffers();
-	void SetupShaders();
-	void SetupAttributes();
-	void SetupTexture(const std::string&);
-
-	int GetTileFromPick(const unsigned int& rgbVal) const;
-
-	GLuint LoadTexture(std::string imagePath) const;
-	void BindTexture(GLenum TextureUnit, GLuint tex) const;
-
-	bool CheckShader(const GLuint& shader) const;
+	virtual ~BoardRenderer() {}
 
-	void RenderPass();
+	//SetupTiles comes first, Init builds whatever drawing needs from the tiles
+	virtual void SetupTiles(const Board& gameBoard) = 0;
+	virtual void Init() = 0;
+	virtual void Cleanup() = 0;
 
-	GLFWwindow* mWindow;
-	const float WINDOW_WIDTH;
-	const float WINDOW_HEIGHT;
+	virtual void SetSelection(const AxialCoord& position) = 0;
+	virtual void SetTileType(int tileID, ResourceType type) = 0;
 
-	GLuint mVertexShader;
-	GLuint mGeometryShader;
-	GLuint mFragmentShader;
-	GLuint mShaderProgram;
+	//pan by window pixels, zoom about the mouse
+	virtual void PanCamera(float dxPixels, float dyPixels) = 0;
+	virtual void ZoomCamera(float factor) = 0;
 
-	GLint mSelectedPointUniform;
-	GLint mPosAttrib;
+	//tile under the mouse, INT_MAX if there isn't one
+	virtual int DoPick() = 0;
 
-	GLuint mColorBuffer;
-	GLuint mVertexBuffer;
+	//draws and presents a frame, whether or not anything changed
+	virtual void RenderScene() = 0;
 
-	std::vector<glm::vec3>* mColorBufferPtr;
-	std::vector<glm::vec2> mVertexInfo;
-	std::vector<glm::vec3> mColorInfo;
-	std::vector<glm::vec3> mColorIDs;
-	std::unordered_map<unsigned int, int> mColorToTileMap;
+	//one pass of an event driven loop: draws a frame if something changed, then
+	// waits until there's more to do or nextDeadline
+	virtual void RunFrame(FramePacer::Clock::time_point nextDeadline) = 0;
+	virtual void RequestRedraw() = 0;
+	virtual bool NeedsRedraw() const = 0;
 };
@@ -0,0 +1,138 @@
+#include "Camera.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	//far enough out to see all of a radius 200 board, close enough in for a
+	// handful of tiles to fill the window
+	const float MIN_ZOOM = 1.f / 64.f;
+	const float MAX_ZOOM = 8.f;
+}
+
+Camera::Camera(float viewportWidth, float viewportHeight)
+	: mViewportWidth(viewportWidth)
+	, mViewportHeight(viewportHeight)
+	, mCenterX(0.f)
+	, mCenterY(0.f)
+	, mZoom(1.f)
+{
+	assert(viewportWidth > 0.f && viewportHeight > 0.f);
+}
+
+void
+Camera::SetCenter(float x, float y)
+{
+	mCenterX = x;
+	mCenterY = y;
+}
+
+void
+Camera::GetCenter(float& x, float& y) const
+{
+	x = mCenterX;
+	y = mCenterY;
+}
+
+void
+Camera::SetZoom(float zoom)
+{
+	mZoom = std::min(std::max(zoom, MIN_ZOOM), MAX_ZOOM);
+}
+
+float
+Camera::GetZoom() const
+{
+	return mZoom;
+}
+
+float
+Camera::GetMinZoom()
+{
+	return MIN_ZOOM;
+}
+
+float
+Camera::GetMaxZoom()
+{
+	return MAX_ZOOM;
+}
+
+void
+Camera::Pan(float dxPixels, float dyPixels)
+{
+	mCenterX += dxPixels * 2.f * GetViewHalfWidth() / mViewportWidth;
+	mCenterY += dyPixels * 2.f * GetViewHalfHeight() / mViewportHeight;
+}
+
+void
+Camera::ZoomAt(float factor, double windowX, double windowY)
+{
+	assert(factor > 0.f);
+
+	//zoom about the center, then slide the view so the anchor is back under the window position
+	float anchorX, anchorY;
+	WindowToWorld(anchorX, anchorY, windowX, windowY);
+
+	SetZoom(mZoom * factor);
+
+	float movedX, movedY;
+	WindowToWorld(movedX, movedY, windowX, windowY);
+	mCenterX += anchorX - movedX;
+	mCenterY += anchorY - movedY;
+}
+
+void
+Camera::WindowToWorld(float& x, float& y, double windowX, double windowY) const
+{
+	x = static_cast<float>(mCenterX + (2.0 * windowX / mViewportWidth - 1.0) * GetViewHalfWidth());
+	y = static_cast<float>(mCenterY + (2.0 * windowY / mViewportHeight - 1.0) * GetViewHalfHeight());
+}
+
+void
+Camera::WorldToWindow(float& windowX, float& windowY, float x, float y) const
+{
+	windowX = ((x - mCenterX) / GetViewHalfWidth() + 1.f) * 0.5f * mViewportWidth;
+	windowY = ((y - mCenterY) / GetViewHalfHeight() + 1.f) * 0.5f * mViewportHeight;
+}
+
+float
+Camera::GetPixelsPerWorldUnit() const
+{
+	return mViewportWidth / (2.f * GetViewHalfWidth());
+}
+
+HexLayout::WorldRect
+Camera::GetViewBounds() const
+{
+	return HexLayout::WorldRect(mCenterX - GetViewHalfWidth(), mCenterY - GetViewHalfHeight(),
+		mCenterX + GetViewHalfWidth(), mCenterY + GetViewHalfHeight());
+}
+
+void
+Camera::GetViewProjection(float matrix[16]) const
+{
+	const float scaleX = 1.f / GetViewHalfWidth();
+	const float scaleY = 1.f / GetViewHalfHeight();
+
+	std::fill(matrix, matrix + 16, 0.f);
+	matrix[0] = scaleX;
+	matrix[5] = scaleY;
+	matrix[10] = 1.f;
+	matrix[12] = -mCenterX * scaleX;
+	matrix[13] = -mCenterY * scaleY;
+	matrix[15] = 1.f;
+}
+
+float
+Camera::GetViewHalfWidth() const
+{
+	return HexLayout::VIEW_HALF_WIDTH / mZoom;
+}
+
+float
+Camera::GetViewHalfHeight() const
+{
+	return HexLayout::VIEW_HALF_HEIGHT / mZoom;
+}
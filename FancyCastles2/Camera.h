@@ -0,0 +1,49 @@
+#pragma once
+
+#include "HexLayout.h"
+
+//Orthographic 2D camera over the board's world units. At a zoom of 1 it shows
+// HexLayout::VIEW_HALF_WIDTH/HEIGHT either side of its center, zooming in
+// shrinks that. Window positions are in pixels with y measured up from the bottom
+class Camera
+{
+public:
+	Camera(float viewportWidth, float viewportHeight);
+
+	void SetCenter(float x, float y);
+	void GetCenter(float& x, float& y) const;
+
+	//clamped to [GetMinZoom(), GetMaxZoom()]
+	void SetZoom(float zoom);
+	float GetZoom() const;
+	static float GetMinZoom();
+	static float GetMaxZoom();
+
+	//moves the view by window pixels, positive goes right/up
+	void Pan(float dxPixels, float dyPixels);
+
+	//multiplies the zoom by factor, the world point under the window position stays put
+	void ZoomAt(float factor, double windowX, double windowY);
+
+	void WindowToWorld(float& x, float& y, double windowX, double windowY) const;
+	void WorldToWindow(float& windowX, float& windowY, float x, float y) const;
+
+	//how big a world unit is on screen
+	float GetPixelsPerWorldUnit() const;
+
+	//the part of the world that's on screen
+	HexLayout::WorldRect GetViewBounds() const;
+
+	//world to clip space, column major for glUniformMatrix4fv
+	void GetViewProjection(float matrix[16]) const;
+
+private:
+	float GetViewHalfWidth() const;
+	float GetViewHalfHeight() const;
+
+	float mViewportWidth;
+	float mViewportHeight;
+	float mCenterX;
+	float mCenterY;
+	float mZoom;
+};
@@ -0,0 +1,121 @@
+#include "ChunkImpostors.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	const int TEXELS_PER_CHUNK = ChunkImpostors::IMPOSTOR_SIZE * ChunkImpostors::IMPOSTOR_SIZE;
+
+	//each texel looks at SAMPLES x SAMPLES points to decide on its type
+	const int SAMPLES = 3;
+
+	//hexes narrower than this many pixels get drawn as impostors
+	const float MIN_HEX_PIXELS = 3.f;
+}
+
+const int ChunkImpostors::IMPOSTOR_SIZE;
+const unsigned char ChunkImpostors::NO_TILE;
+
+ChunkImpostors::ChunkImpostors()
+{
+}
+
+ChunkImpostors::ChunkImpostors(int numChunks)
+	: mTexels(numChunks * TEXELS_PER_CHUNK, NO_TILE)
+	, mChunkDirty(numChunks, false)
+{
+	MarkAllDirty();
+}
+
+bool
+ChunkImpostors::ShouldDraw(float pixelsPerWorldUnit)
+{
+	return HexLayout::HEX_WIDTH * pixelsPerWorldUnit < MIN_HEX_PIXELS;
+}
+
+void
+ChunkImpostors::MarkChunkDirty(int chunkIndex)
+{
+	assert(chunkIndex >= 0 && chunkIndex < static_cast<int>(mChunkDirty.size()));
+	if (mChunkDirty[chunkIndex])
+		return;
+
+	mChunkDirty[chunkIndex] = true;
+	mDirtyChunks.push_back(chunkIndex);
+}
+
+void
+ChunkImpostors::MarkAllDirty()
+{
+	for (int chunkIndex = 0; chunkIndex < static_cast<int>(mChunkDirty.size()); ++chunkIndex)
+		MarkChunkDirty(chunkIndex);
+}
+
+bool
+ChunkImpostors::AnyDirty() const
+{
+	return !mDirtyChunks.empty();
+}
+
+void
+ChunkImpostors::UpdateDirty(const BoardChunks& chunks, const TileIndexView& index,
+	const unsigned char* slotTypes, size_t slotStride, std::vector<int>& rebuiltChunks)
+{
+	assert(chunks.GetNumChunks() == static_cast<int>(mChunkDirty.size()));
+
+	std::sort(mDirtyChunks.begin(), mDirtyChunks.end());
+	for (const auto chunkIndex : mDirtyChunks)
+	{
+		BuildChunk(chunkIndex, chunks, index, slotTypes, slotStride);
+		mChunkDirty[chunkIndex] = false;
+	}
+
+	rebuiltChunks.swap(mDirtyChunks);
+	mDirtyChunks.clear();
+}
+
+const unsigned char*
+ChunkImpostors::GetTexels(int chunkIndex) const
+{
+	return &mTexels[chunkIndex * TEXELS_PER_CHUNK];
+}
+
+void
+ChunkImpostors::BuildChunk(int chunkIndex, const BoardChunks& chunks, const TileIndexView& index,
+	const unsigned char* slotTypes, size_t slotStride)
+{
+	const auto& chunk = chunks.GetChunk(chunkIndex);
+	const float texelWidth = (chunk.mBounds.mMaxX - chunk.mBounds.mMinX) / IMPOSTOR_SIZE;
+	const float texelHeight = (chunk.mBounds.mMaxY - chunk.mBounds.mMinY) / IMPOSTOR_SIZE;
+	auto texel = &mTexels[chunkIndex * TEXELS_PER_CHUNK];
+
+	for (int texelY = 0; texelY < IMPOSTOR_SIZE; ++texelY)
+	{
+		for (int texelX = 0; texelX < IMPOSTOR_SIZE; ++texelX, ++texel)
+		{
+			//count which tile each sample point lands on, tiles from other
+			// chunks are left for their own impostor
+			int typeCounts[static_cast<int>(ResourceType::NUMTYPES)] = {};
+			for (int sample = 0; sample < SAMPLES * SAMPLES; ++sample)
+			{
+				const float x = chunk.mBounds.mMinX + texelWidth * (texelX + (sample % SAMPLES + 0.5f) / SAMPLES);
+				const float y = chunk.mBounds.mMinY + texelHeight * (texelY + (sample / SAMPLES + 0.5f) / SAMPLES);
+				const auto position = HexLayout::GetAxialFromCartesian(x, y);
+				if (!index.IsPositionValid(position))
+					continue;
+
+				const auto slot = chunks.GetTileSlot(index.GetTileIndex(position));
+				if (slot < chunk.mFirstSlot || slot >= chunk.mFirstSlot + chunk.mNumTiles)
+					continue;
+
+				const auto type = slotTypes[slot * slotStride];
+				assert(type < static_cast<int>(ResourceType::NUMTYPES));
+				typeCounts[type]++;
+			}
+
+			const auto dominant = std::max_element(std::begin(typeCounts), std::end(typeCounts));
+			*texel = *dominant > 0 ? static_cast<unsigned char>(dominant - std::begin(typeCounts)) : NO_TILE;
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "BoardChunks.h"
+#include "TileRanges.h"
+
+//Low detail stand-ins for zoomed out views. Each chunk gets an
+// IMPOSTOR_SIZE x IMPOSTOR_SIZE grid of ResourceType values stretched over its
+// bounds, every texel holding the type that covers most of its part of the
+// world. Once hexes are only a few pixels across one quad per chunk looks the
+// same as hundreds of hexes and costs next to nothing.
+//Texel rows run from the bottom of the chunk bounds up
+class ChunkImpostors
+{
+public:
+	static const int IMPOSTOR_SIZE = 16;
+
+	//texel value where no tile of the chunk is
+	static const unsigned char NO_TILE = 255;
+
+	ChunkImpostors();
+	explicit ChunkImpostors(int numChunks);
+
+	//true once hexes are too small on screen to be worth drawing one by one
+	static bool ShouldDraw(float pixelsPerWorldUnit);
+
+	void MarkChunkDirty(int chunkIndex);
+	void MarkAllDirty();
+	bool AnyDirty() const;
+
+	//regenerates every dirty chunk from the tile types and fills rebuiltChunks with
+	// their indices. slotTypes[slot * slotStride] is the ResourceType of the tile
+	// in that draw slot
+	void UpdateDirty(const BoardChunks& chunks, const TileIndexView& index,
+		const unsigned char* slotTypes, size_t slotStride, std::vector<int>& rebuiltChunks);
+
+	//IMPOSTOR_SIZE * IMPOSTOR_SIZE texels
+	const unsigned char* GetTexels(int chunkIndex) const;
+
+private:
+	void BuildChunk(int chunkIndex, const BoardChunks& chunks, const TileIndexView& index,
+		const unsigned char* slotTypes, size_t slotStride);
+
+	std::vector<unsigned char> mTexels;
+	std::vector<bool> mChunkDirty;
+	std::vector<int> mDirtyChunks;
+};
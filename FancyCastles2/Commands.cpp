@@ -18,6 +18,22 @@ MoveSelectionCommand::GetOffset() const
 	return mOffset;
 }
 
+SelectTileCommand::SelectTileCommand(int tileID)
+	: mTileID(tileID)
+{
+}
+
+void
+SelectTileCommand::Execute()
+{
+}
+
+int
+SelectTileCommand::GetTileID() const
+{
+	return mTileID;
+}
+
 void
 PickSelectionCommand::Execute()
 {
@@ -36,6 +52,44 @@ BuildCommand::Execute()
 	//gm->Build();
 }
 
+PanCameraCommand::PanCameraCommand(float dxPixels, float dyPixels)
+	: mDX(dxPixels), mDY(dyPixels)
+{
+}
+
+void
+PanCameraCommand::Execute()
+{
+}
+
+float
+PanCameraCommand::GetDX() const
+{
+	return mDX;
+}
+
+float
+PanCameraCommand::GetDY() const
+{
+	return mDY;
+}
+
+ZoomCameraCommand::ZoomCameraCommand(float factor)
+	: mFactor(factor)
+{
+}
+
+void
+ZoomCameraCommand::Execute()
+{
+}
+
+float
+ZoomCameraCommand::GetFactor() const
+{
+	return mFactor;
+}
+
 void
 ExitGameCommand::Execute()
 {
@@ -23,6 +23,20 @@ private:
 	AxialCoord mOffset;
 };
 
+//selects a tile by ID, for when there's no mouse to pick with
+class SelectTileCommand : public Command
+{
+public:
+	SelectTileCommand(int tileID);
+
+	void Execute() override;
+
+	int GetTileID() const;
+
+private:
+	int mTileID;
+};
+
 class HarvestCommand : public Command
 {
 public:
@@ -41,6 +55,35 @@ public:
 	void Execute() override;
 };
 
+class PanCameraCommand : public Command
+{
+public:
+	//window pixels, positive moves the view right/up
+	PanCameraCommand(float dxPixels, float dyPixels);
+
+	void Execute() override;
+
+	float GetDX() const;
+	float GetDY() const;
+
+private:
+	float mDX;
+	float mDY;
+};
+
+class ZoomCameraCommand : public Command
+{
+public:
+	ZoomCameraCommand(float factor);
+
+	void Execute() override;
+
+	float GetFactor() const;
+
+private:
+	float mFactor;
+};
+
 class NullCommand : public Command
 {
 public:
@@ -0,0 +1,69 @@
+#include "DirtyTileRanges.h"
+
+#include <cassert>
+
+DirtyTileRanges::DirtyTileRanges() : mNumDirty(0)
+{
+}
+
+DirtyTileRanges::DirtyTileRanges(int numTiles)
+	: mDirtyTiles(numTiles)
+	, mNumDirty(0)
+{
+}
+
+void
+DirtyTileRanges::MarkDirty(int tileID)
+{
+	assert(tileID >= 0 && tileID < mDirtyTiles.GetNumTiles());
+	if (mDirtyTiles.Test(tileID))
+		return;
+
+	mDirtyTiles.Set(tileID);
+	mNumDirty++;
+}
+
+void
+DirtyTileRanges::MarkAllDirty()
+{
+	for (int tileID = 0; tileID < mDirtyTiles.GetNumTiles(); ++tileID)
+		mDirtyTiles.Set(tileID);
+
+	mNumDirty = mDirtyTiles.GetNumTiles();
+}
+
+bool
+DirtyTileRanges::Any() const
+{
+	return mNumDirty > 0;
+}
+
+int
+DirtyTileRanges::Count() const
+{
+	return mNumDirty;
+}
+
+void
+DirtyTileRanges::TakeRanges(int maxGap, DirtyTileRangeList& ranges)
+{
+	ranges.clear();
+	if (mNumDirty == 0)
+		return;
+
+	//set bits come back in increasing order, so each one either extends the last run or starts a new one
+	mDirtyTiles.ForEach([maxGap, &ranges](int tileID)
+	{
+		if (!ranges.empty() && tileID - ranges.back().mEnd <= maxGap)
+		{
+			ranges.back().mEnd = tileID + 1;
+			return;
+		}
+
+		DirtyTileRange range = { tileID, tileID + 1 };
+		ranges.push_back(range);
+	});
+
+	mDirtyTiles.Clear();
+	mNumDirty = 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "TileBitSet.h"
+
+//a run of tile IDs [mBegin, mEnd) that needs uploading
+struct DirtyTileRange
+{
+	int mBegin;
+	int mEnd;
+};
+
+using DirtyTileRangeList = std::vector < DirtyTileRange > ;
+
+//Remembers which tiles changed since the last upload and hands them back as
+// sorted runs, so a per-tile GPU buffer only re-sends what changed.
+//Runs separated by at most maxGap clean tiles are merged, since one
+// bigger upload is cheaper than several tiny ones
+class DirtyTileRanges
+{
+public:
+	DirtyTileRanges();
+	explicit DirtyTileRanges(int numTiles);
+
+	void MarkDirty(int tileID);
+	void MarkAllDirty();
+	bool Any() const;
+	int Count() const;
+
+	//fills ranges with the dirty runs in increasing order and marks every tile clean
+	void TakeRanges(int maxGap, DirtyTileRangeList& ranges);
+
+private:
+	TileBitSet mDirtyTiles;
+	int mNumDirty;
+};
@@ -3,13 +3,32 @@
 
 #include <vld.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+
 #include "Board.h"
 #include "BoardController.h"
-#include "BoardRenderer.h"
 #include "GameManager.h"
+#include "GameSimulation.h"
+#include "GLBoardRenderer.h"
 #include "InputHandler.h"
+#include "MatchRunner.h"
 #include "Player.h"
 #include "PlayerController.h"
+#include "ReplayLog.h"
+#include "SoftwareBoardRenderer.h"
 #include "TileChooser.h"
 #include "Timer.h"
 
@@ -17,6 +36,11 @@ const int WINDOW_WIDTH = 1366;
 const int WINDOW_HEIGHT = 768;
 const float ASPECT_RATIO = WINDOW_WIDTH / WINDOW_HEIGHT;
 const int NUM_PLAYERS = 6;
+const int NUM_STARTING_BILLS = 5;
+
+//the loop only draws when something changes, and never faster than this
+const double MAX_FRAMES_PER_SECOND = 60.0;
+const bool USE_VSYNC = true;
 
 using PlayerList = std::vector < std::unique_ptr<Player> > ;
 
@@ -50,24 +74,53 @@ CreateRenderWindow()
 }
 
 std::unique_ptr<Board>
-CreateGameBoard()
+CreateGameBoard(int numTilesPerType)
 {
 	auto gameBoard = std::make_unique<Board>();
-	gameBoard->MakeBoard(NUM_PLAYERS);
+	gameBoard->MakeBoard(numTilesPerType);
 
 	return gameBoard;
 }
 
-std::unique_ptr<BoardRenderer>
-CreateGameRenderer(const Board& board, GLFWwindow* window)
+std::unique_ptr<GLBoardRenderer>
+CreateGameRenderer(const Board& board, GLFWwindow* window, const RendererAssets& assets)
 {
-	auto renderComponent = std::make_unique<BoardRenderer>(window, WINDOW_WIDTH, WINDOW_HEIGHT);
+	auto renderComponent = std::make_unique<GLBoardRenderer>(window, WINDOW_WIDTH, WINDOW_HEIGHT);
 	renderComponent->SetupTiles(board);
-	renderComponent->Init();
+	renderComponent->Init(assets);
+	renderComponent->SetMaxFramesPerSecond(MAX_FRAMES_PER_SECOND);
+	renderComponent->SetVSync(USE_VSYNC);
 
 	return renderComponent;
 }
 
+//everything up to the first frame. The board and the renderer's files don't
+// need the GL context, so they're made on worker threads while the window and
+// context are made on this one. A file that won't load is reported from here,
+// after the worker threads are done
+void
+LoadGame(int numTilesPerType, GLFWwindow*& window, std::unique_ptr<Board>& board, std::unique_ptr<GLBoardRenderer>& renderer)
+{
+	auto boardLoad = std::async(std::launch::async, CreateGameBoard, numTilesPerType);
+	auto assetLoad = std::async(std::launch::async, GLBoardRenderer::LoadAssets);
+
+	window = CreateRenderWindow();
+	board = boardLoad.get();
+
+	RendererAssets assets;
+	try
+	{
+		assets = assetLoad.get();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		glfwTerminate();
+		exit(EXIT_FAILURE);
+	}
+	renderer = CreateGameRenderer(*board, window, assets);
+}
+
 std::unique_ptr<InputHandler>
 CreateInputHandler(GLFWwindow* renderWindow)
 {
@@ -78,30 +131,312 @@ CreateInputHandler(GLFWwindow* renderWindow)
 }
 
 std::shared_ptr<PlayerController>
-CreatePlayerController(int numPlayers)
+CreatePlayerController(int numPlayers, const BoardController& boardController)
 {
-	const int numBills = 5;
 	PlayerList players;
 	for (int playerId = 0; playerId < numPlayers; ++playerId)
 	{
 		auto timer = std::make_unique<TimerObject>(playerId);
-		players.push_back(std::make_unique<Player>(playerId, std::move(timer), numBills));
+		players.push_back(std::make_unique<Player>(playerId, std::move(timer), NUM_STARTING_BILLS));
 	}
 
-	return std::make_shared<PlayerController>(players);
+	return std::make_shared<PlayerController>(players, boardController);
 }
 
-int main(void)
+int
+RunDrawBenchmark(int numTilesPerType)
 {
-	auto renderWindow = CreateRenderWindow();
-	auto inputComponent = CreateInputHandler(renderWindow);
+	//compare the hex drawing paths on a board of the given size, then quit
+	const int numFrames = 200;
+	GLFWwindow* renderWindow;
+	std::unique_ptr<Board> gameBoard;
+	std::unique_ptr<GLBoardRenderer> renderComponent;
+	LoadGame(numTilesPerType, renderWindow, gameBoard, renderComponent);
+
+	renderComponent->BenchmarkDrawPaths(numFrames);
+	renderComponent->Cleanup();
+
+	glfwDestroyWindow(renderWindow);
+	glfwTerminate();
+	return 0;
+}
+
+int
+RunStartupBenchmark()
+{
+	//time from nothing to a renderer ready to draw. The program cache only
+	// helps the second and later runs, so run this at least twice
+	const auto start = std::chrono::steady_clock::now();
+	GLFWwindow* renderWindow;
+	std::unique_ptr<Board> gameBoard;
+	std::unique_ptr<GLBoardRenderer> renderComponent;
+	LoadGame(NUM_PLAYERS, renderWindow, gameBoard, renderComponent);
+	glFinish();
+	const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+	std::cout << "ready in " << elapsed.count() << " ms, " << renderComponent->GetNumCachedPrograms() << " programs from the cache, "
+		<< renderComponent->GetNumLinkedPrograms() << " linked" << std::endl;
+
+	renderComponent->Cleanup();
+	glfwDestroyWindow(renderWindow);
+	glfwTerminate();
+	return 0;
+}
+
+std::chrono::steady_clock::duration
+GetGameLength(double gameMinutes)
+{
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::ratio<60>>(gameMinutes));
+}
+
+int
+RunSimulations(int numGames, double gameMinutes)
+{
+	//whole games with no window, each on its own seed, spread over every core
+	SimulationSettings base;
+	base.mNumPlayers = NUM_PLAYERS;
+	base.mGameLength = GetGameLength(gameMinutes);
+	MatchSweep sweep;
+	sweep.mGamesPerSetting = numGames;
+	const auto matches = MatchRunner::MakeSweep(base, sweep);
+
+	const MatchRunner runner;
+	const auto start = std::chrono::steady_clock::now();
+	const auto results = runner.Run(matches);
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+	long long numHarvests = 0;
+	long long numResources = 0;
+	for (const auto& result : results)
+	{
+		numHarvests += result.mNumHarvests;
+		for (auto resources : result.mResourcesPerPlayer)
+			numResources += resources;
+	}
+
+	std::cout << numGames << " games on " << runner.GetNumThreads() << " threads in " << elapsed.count() << "s ("
+		<< numGames / std::max(elapsed.count(), 1e-9) << " per second), "
+		<< static_cast<double>(numHarvests) / std::max(numGames, 1) << " harvests and "
+		<< static_cast<double>(numResources) / std::max(numGames, 1) << " resources per game" << std::endl;
+	return 0;
+}
+
+int
+RunSweep(const std::string& filename, int gamesPerSetting, double gameMinutes)
+{
+	//every combination of player count, board size, starting bills and harvest rate,
+	// one csv row per game
+	SimulationSettings base;
+	base.mGameLength = GetGameLength(gameMinutes);
+	MatchSweep sweep;
+	sweep.mNumPlayers = { 2, 3, 4, 5, 6 };
+	sweep.mNumTilesPerType = { 20, 40, 80 };
+	sweep.mNumStartingBills = { 0, 5, 10 };
+	sweep.mHarvestRateBonuses = { 0, 1, 2 };
+	sweep.mGamesPerSetting = gamesPerSetting;
+	const auto matches = MatchRunner::MakeSweep(base, sweep);
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto results = MatchRunner().Run(matches);
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+	std::ofstream out(filename);
+	if (!out)
+	{
+		std::cerr << "Couldn't open " << filename << std::endl;
+		return 1;
+	}
+	MatchRunner::WriteCsv(out, matches, results);
+	std::cout << matches.size() << " games in " << elapsed.count() << "s, written to " << filename << std::endl;
+	return 0;
+}
+
+int
+RunReplay(const std::string& filename)
+{
+	//play a recorded game back with no window, as fast as it goes
+	std::ifstream in(filename, std::ios::binary);
+	ReplayHeader header;
+	ReplayEventList events;
+	if (!in || !ReplayLog::Read(in, header, events))
+	{
+		std::cerr << "Couldn't read all of " << filename << ", replaying " << events.size() << " events" << std::endl;
+		if (events.empty())
+			return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto result = ReplayLog::Play(header, events);
+	const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+	std::cout << events.size() << " events (" << result.mNumCommands << " commands, " << result.mNumTimersRecorded
+		<< " timers) replayed in " << elapsed.count() << "s, " << result.mNumTimerMismatches << " timers differ" << std::endl;
+	for (int playerID = 0; playerID < header.mNumPlayers; ++playerID)
+		std::cout << "player " << playerID << ": " << result.mResourcesPerPlayer[playerID] << " resources" << std::endl;
+	return result.mNumTimerMismatches == 0 ? 0 : 1;
+}
+
+std::shared_ptr<ReplayRecorder>
+CreateRecorder(ReplayWriter& writer, const ReplayHeader& header, const PlayerController& playerController)
+{
+	//the recording starts with who got which tiles, in tile order so it's the same every time
+	auto recorder = std::make_shared<ReplayRecorder>(writer, std::make_shared<RealGameClock>(), header);
+	for (int playerID = 0; playerID < header.mNumPlayers; ++playerID)
+	{
+		const auto playerTiles = playerController.GetPlayerTiles(playerID);
+		std::vector<int> tileIDs(playerTiles.begin(), playerTiles.end());
+		std::sort(tileIDs.begin(), tileIDs.end());
+		for (auto tileID : tileIDs)
+			recorder->RecordTileAssigned(tileID, playerID);
+	}
+
+	return recorder;
+}
+
+int
+RunScreenshot(const std::string& filename, int numTilesPerType)
+{
+	//draw the board with the software renderer and save it, no window or GPU needed
+	auto gameBoard = CreateGameBoard(numTilesPerType);
+	SoftwareBoardRenderer renderComponent(WINDOW_WIDTH, WINDOW_HEIGHT);
+	renderComponent.SetupTiles(*gameBoard);
+	renderComponent.Init();
+	renderComponent.RenderScene();
+
+	if (!renderComponent.SaveImage(filename))
+	{
+		std::cerr << "couldn't write " << filename << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "drew " << renderComponent.GetLastDrawnTiles() << " tiles to " << filename << std::endl;
+	return 0;
+}
+
+double
+GetProcessCPUSeconds()
+{
+	//user + kernel time of the whole process. clock() is wall time on Windows
+#ifdef _WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+	const auto toSeconds = [](const FILETIME& time)
+	{
+		return ((static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1e-7;
+	};
+	return toSeconds(kernelTime) + toSeconds(userTime);
+#else
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+int
+RunIdleBenchmark(double seconds)
+{
+	//CPU used while sitting on an unchanging board, first redrawing as fast as
+	// possible like the old loop did, then with the event driven loop
+	GLFWwindow* renderWindow;
+	std::unique_ptr<Board> gameBoard;
+	std::unique_ptr<GLBoardRenderer> renderComponent;
+	LoadGame(NUM_PLAYERS, renderWindow, gameBoard, renderComponent);
 
-	auto gameBoard = CreateGameBoard();
+	const char* loopNames[] = { "busy loop", "event driven loop" };
+	for (int loop = 0; loop < 2; ++loop)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+		const auto startCPU = GetProcessCPUSeconds();
+		int numFrames = 0;
+
+		renderComponent->RequestRedraw();
+		while (std::chrono::steady_clock::now() < end)
+		{
+			if (loop == 0)
+			{
+				renderComponent->RenderScene();
+				glfwPollEvents();
+				numFrames++;
+			}
+			else
+			{
+				numFrames += renderComponent->NeedsRedraw() ? 1 : 0;
+				renderComponent->RunFrame(end);
+			}
+		}
+
+		const auto wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const auto cpuSeconds = GetProcessCPUSeconds() - startCPU;
+		std::cout << loopNames[loop] << ": " << numFrames << " frames, " << cpuSeconds << "s CPU in "
+			<< wallSeconds << "s (" << 100.0 * cpuSeconds / wallSeconds << "% of a core)" << std::endl;
+	}
+
+	renderComponent->Cleanup();
+	glfwDestroyWindow(renderWindow);
+	glfwTerminate();
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	//FancyCastles --benchmark-draw [tiles per type]
+	if (argc > 1 && std::string(argv[1]) == "--benchmark-draw")
+		return RunDrawBenchmark(argc > 2 ? std::atoi(argv[2]) : NUM_PLAYERS);
+
+	//FancyCastles --benchmark-idle [seconds per loop]
+	if (argc > 1 && std::string(argv[1]) == "--benchmark-idle")
+		return RunIdleBenchmark(argc > 2 ? std::atof(argv[2]) : 10.0);
+
+	//FancyCastles --benchmark-startup
+	if (argc > 1 && std::string(argv[1]) == "--benchmark-startup")
+		return RunStartupBenchmark();
+
+	//FancyCastles --simulate [games] [minutes per game]
+	if (argc > 1 && std::string(argv[1]) == "--simulate")
+		return RunSimulations(argc > 2 ? std::atoi(argv[2]) : 1000, argc > 3 ? std::atof(argv[3]) : 10.0);
+
+	//FancyCastles --sweep file.csv [games per setting] [minutes per game]
+	if (argc > 2 && std::string(argv[1]) == "--sweep")
+		return RunSweep(argv[2], argc > 3 ? std::atoi(argv[3]) : 10, argc > 4 ? std::atof(argv[4]) : 10.0);
+
+	//FancyCastles --replay file.fcr
+	if (argc > 2 && std::string(argv[1]) == "--replay")
+		return RunReplay(argv[2]);
+
+	//FancyCastles --screenshot file.ppm [tiles per type]
+	if (argc > 2 && std::string(argv[1]) == "--screenshot")
+		return RunScreenshot(argv[2], argc > 3 ? std::atoi(argv[3]) : NUM_PLAYERS);
+
+	//FancyCastles --record file.fcr, plays as normal and records the game
+	std::ofstream replayFile;
+	if (argc > 2 && std::string(argv[1]) == "--record")
+	{
+		replayFile.open(argv[2], std::ios::binary);
+		if (!replayFile)
+		{
+			std::cerr << "Couldn't open " << argv[2] << std::endl;
+			return 1;
+		}
+	}
+
+	GLFWwindow* renderWindow;
+	std::unique_ptr<Board> gameBoard;
+	std::unique_ptr<GLBoardRenderer> renderComponent;
+	LoadGame(NUM_PLAYERS, renderWindow, gameBoard, renderComponent);
+
+	ReplayHeader replayHeader;
+	replayHeader.mSeed = gameBoard->GetSeed();
+	replayHeader.mNumTilesPerType = NUM_PLAYERS;
+	replayHeader.mNumPlayers = NUM_PLAYERS;
+	replayHeader.mNumStartingBills = NUM_STARTING_BILLS;
+	std::unique_ptr<ReplayWriter> replayWriter;
+	if (replayFile.is_open())
+		replayWriter = std::make_unique<ReplayWriter>(replayFile);
+
+	auto inputComponent = CreateInputHandler(renderWindow);
 	const auto numTiles = gameBoard->GetNumTiles();
 
-	auto renderComponent = CreateGameRenderer(*gameBoard, renderWindow);
 	auto boardController = std::make_unique<BoardController>(std::move(gameBoard));
-	auto playerController = CreatePlayerController(NUM_PLAYERS);
+	auto playerController = CreatePlayerController(NUM_PLAYERS, *boardController);
 
 	{
 		auto chooser = std::make_shared<TileChooser>(NUM_PLAYERS, 10, *renderComponent);
@@ -115,6 +450,8 @@ int main(void)
 		auto manager = std::make_shared<GameManager>(std::move(renderComponent), std::move(boardController), playerController);
 		inputComponent->AddObserver(manager);
 		playerController->ObserveTimers(manager);
+		if (replayWriter)
+			manager->SetRecorder(CreateRecorder(*replayWriter, replayHeader, *playerController));
 
 		manager->StartGame();
 	}
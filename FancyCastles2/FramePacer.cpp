@@ -0,0 +1,64 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+FramePacer::Clock::time_point
+FramePacer::NoDeadline()
+{
+	return Clock::time_point::max();
+}
+
+FramePacer::FramePacer(double maxFramesPerSecond)
+	: mMaxFramesPerSecond(0.0)
+	, mMinFrameInterval(Clock::duration::zero())
+	, mHasDrawnFrame(false)
+{
+	SetMaxFramesPerSecond(maxFramesPerSecond);
+}
+
+void
+FramePacer::SetMaxFramesPerSecond(double maxFramesPerSecond)
+{
+	assert(maxFramesPerSecond >= 0.0);
+	mMaxFramesPerSecond = maxFramesPerSecond;
+	mMinFrameInterval = maxFramesPerSecond > 0.0 ?
+		std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / maxFramesPerSecond)) :
+		Clock::duration::zero();
+}
+
+double
+FramePacer::GetMaxFramesPerSecond() const
+{
+	return mMaxFramesPerSecond;
+}
+
+bool
+FramePacer::CanDrawFrame(Clock::time_point now) const
+{
+	return !mHasDrawnFrame || now - mLastFrame >= mMinFrameInterval;
+}
+
+void
+FramePacer::OnFrameDrawn(Clock::time_point now)
+{
+	mLastFrame = now;
+	mHasDrawnFrame = true;
+}
+
+double
+FramePacer::GetWaitSeconds(Clock::time_point now, bool needsRedraw, Clock::time_point nextDeadline) const
+{
+	auto wakeTime = nextDeadline;
+	if (needsRedraw)
+		wakeTime = std::min(wakeTime, mHasDrawnFrame ? mLastFrame + mMinFrameInterval : now);
+
+	if (wakeTime == NoDeadline())
+		return std::numeric_limits<double>::infinity();
+
+	if (wakeTime <= now)
+		return 0.0;
+
+	return std::chrono::duration<double>(wakeTime - now).count();
+}
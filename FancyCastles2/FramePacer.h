@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+
+//Decides when the game loop draws and how long it can sleep waiting for input.
+//A frame is only drawn when something on screen changed, and frames are kept
+// at least 1 / max frames per second apart. Between frames the loop sleeps
+// until input arrives, the next frame slot comes up or the next game deadline
+// (a timer finishing) is due
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	//for loops with nothing scheduled, only input can wake them
+	static Clock::time_point NoDeadline();
+
+	//0 means no cap
+	explicit FramePacer(double maxFramesPerSecond = 0.0);
+
+	void SetMaxFramesPerSecond(double maxFramesPerSecond);
+	double GetMaxFramesPerSecond() const;
+
+	bool CanDrawFrame(Clock::time_point now) const;
+	void OnFrameDrawn(Clock::time_point now);
+
+	//how long to wait for events before the loop has work to do, infinity if
+	// nothing but input can give it any
+	double GetWaitSeconds(Clock::time_point now, bool needsRedraw, Clock::time_point nextDeadline) const;
+
+private:
+	double mMaxFramesPerSecond;
+	Clock::duration mMinFrameInterval;
+	Clock::time_point mLastFrame;
+	bool mHasDrawnFrame;
+};
@@ -0,0 +1,1041 @@
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include "SOIL.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Board.h"
+#include "GLBoardRenderer.h"
+#include "HexLayout.h"
+#include "TilePalette.h"
+
+
+namespace
+{
+	//attribute slots are fixed so every program can share the same vertex arrays
+	const GLuint AXIAL_ATTRIB = 0;
+	const GLuint TYPE_AND_FLAGS_ATTRIB = 1;
+	const GLuint CORNER_ATTRIB = 2;
+	const GLuint CORNER_TEXCOORD_ATTRIB = 3;
+	const GLuint CHUNK_BOUNDS_ATTRIB = 4;
+
+	//bits in a tile's flags byte
+	const GLubyte TILE_FLAG_SELECTED = 1;
+
+	//the palette uniform in the shaders has room for this many types
+	const int MAX_PALETTE_SIZE = 8;
+	static_assert(static_cast<int>(ResourceType::NUMTYPES) <= MAX_PALETTE_SIZE, "palette in the shaders is too small");
+
+	//impostor atlas layout, chunk i's block is at column i % ATLAS_COLUMNS, row i / ATLAS_COLUMNS
+	const int ATLAS_COLUMNS = 64;
+	const GLenum IMPOSTOR_TEXTURE_UNIT = GL_TEXTURE1;
+
+	//every file Init needs, LoadAssets reads them all up front
+	const char* const SHADER_FILES[] =
+	{
+		"vert.glsl", "geo.glsl", "hexvert.glsl", "frag.glsl", "pickfrag.glsl",
+		"impostorvert.glsl", "impostorfrag.glsl"
+	};
+	const char* const OUTLINE_TEXTURE_FILE = "TileOutline.png";
+
+	//linked programs are kept here between runs, next to the executable's working directory
+	const char* const PROGRAM_CACHE_DIRECTORY = "shadercache";
+
+	//part of every program's cache key, bump it when anything CreateProgram
+	// sets up outside the shader sources changes (attribute slots, say)
+	const char* const PROGRAM_CACHE_LAYOUT = "attribs 1";
+
+	//r,q, type and flags, nothing else
+	static_assert(sizeof(PackedTile) == 6, "PackedTile should be tightly packed");
+
+	//corners of the shared hex mesh in triangle fan order, with where each
+	// one lands on the selection outline texture
+	const int NUM_HEX_CORNERS = 6;
+	const GLfloat HEX_CORNER_TEXCOORDS[NUM_HEX_CORNERS][2] =
+	{
+		{ 1.0f, 0.75f }, { 0.5f, 1.0f }, { 0.0f, 0.75f },
+		{ 0.0f, 0.25f }, { 0.5f, 0.0f }, { 1.0f, 0.25f }
+	};
+
+	std::string
+	LoadShaderFile(const char* filename)
+	{
+		std::ifstream in(filename);
+		if (in)
+		{
+			std::string contents;
+			in.seekg(0, std::ios::end);
+			contents.resize(in.tellg());
+			in.seekg(0, std::ios::beg);
+			in.read(&contents[0], contents.size());
+			in.close();
+			return(contents);
+		}
+		throw(errno);
+	}
+
+}
+
+GLBoardRenderer::GLBoardRenderer(GLFWwindow* window, int width, int height) :
+	  mWindow(window)
+	, WINDOW_WIDTH(width)
+	, WINDOW_HEIGHT(height)
+	, mDrawPath(HexDrawPath::INSTANCED)
+	, mProgramCache(PROGRAM_CACHE_DIRECTORY)
+	, mNumCachedPrograms(0)
+	, mNumLinkedPrograms(0)
+	, mTileBuffer(0)
+	, mHexMeshBuffer(0)
+	, mImpostorProgram(0)
+	, mImpostorVertexArray(0)
+	, mImpostorQuadBuffer(0)
+	, mChunkBoundsBuffer(0)
+	, mImpostorAtlas(0)
+	, mOutlineTexture(0)
+	, mImpostorViewProjectionUniform(-1)
+	, mPickFramebuffer(0)
+	, mPickIDRenderbuffer(0)
+	, mPickPixelBuffer(0)
+	, mPickFence(nullptr)
+	, mPickPixelCount(0)
+	, mSelectedTile(-1)
+	, mCamera(static_cast<float>(width), static_cast<float>(height))
+	, mLastDrawnTiles(0)
+	, mNeedsRedraw(true)
+	, mLastUploadBytes(0)
+{
+}
+
+RendererAssets
+GLBoardRenderer::LoadAssets()
+{
+	RendererAssets assets;
+	for (const auto filename : SHADER_FILES)
+	{
+		try
+		{
+			assets.mShaderSources[filename] = LoadShaderFile(filename);
+		}
+		catch (int)
+		{
+			throw std::runtime_error(std::string("Couldn't load '") + filename + "'");
+		}
+	}
+
+	//decoded here rather than by SOIL_load_OGL_texture so it doesn't need the context
+	int channels = 0;
+	unsigned char* pixels = SOIL_load_image(OUTLINE_TEXTURE_FILE, &assets.mOutlineWidth, &assets.mOutlineHeight, &channels, SOIL_LOAD_RGBA);
+	if (pixels == nullptr)
+		throw std::runtime_error(std::string("Couldn't load '") + OUTLINE_TEXTURE_FILE + "'");
+
+	//images come top row first, flip them the way SOIL_FLAG_INVERT_Y did
+	const size_t rowBytes = 4 * assets.mOutlineWidth;
+	assets.mOutlinePixels.resize(rowBytes * assets.mOutlineHeight);
+	for (int row = 0; row < assets.mOutlineHeight; ++row)
+		std::copy(pixels + row * rowBytes, pixels + (row + 1) * rowBytes, assets.mOutlinePixels.begin() + (assets.mOutlineHeight - 1 - row) * rowBytes);
+	SOIL_free_image_data(pixels);
+
+	return assets;
+}
+
+void
+GLBoardRenderer::Init()
+{
+	Init(LoadAssets());
+}
+
+void
+GLBoardRenderer::Init(const RendererAssets& assets)
+{
+	SetupBuffers();
+	SetupPickBuffers();
+	SetupShaders(assets);
+	SetupVertexArrays();
+	SetupTexture(assets);
+	SetupImpostors();
+	SetupLayoutUniforms();
+	SetDrawPath(mDrawPath);
+}
+
+void
+GLBoardRenderer::SetupTiles(const Board& gameBoard)
+{
+	//keep the board's coord -> tile index around so picks can be answered without the GPU
+	mTileIndex = gameBoard.GetIndexView();
+
+	std::vector<AxialCoord> tileCoords;
+	for (int tileIndex = 0; tileIndex < gameBoard.GetNumTiles(); ++tileIndex)
+		tileCoords.push_back(gameBoard.GetTileCoord(tileIndex));
+
+	//tiles go to the GPU chunk by chunk so each chunk can be drawn, or skipped, as one run
+	mChunks = BoardChunks(tileCoords);
+	mTiles.resize(gameBoard.GetNumTiles());
+	for (int slot = 0; slot < gameBoard.GetNumTiles(); ++slot)
+	{
+		const auto tileIndex = mChunks.GetSlotTile(slot);
+		const auto type = gameBoard.GetTileType(tileIndex);
+		assert(type < ResourceType::NUMTYPES);
+
+		auto& tile = mTiles[slot];
+		tile.r = static_cast<GLshort>(tileCoords[tileIndex].r);
+		tile.q = static_cast<GLshort>(tileCoords[tileIndex].q);
+		tile.type = static_cast<GLubyte>(type);
+		tile.flags = 0;
+	}
+
+	mImpostors = ChunkImpostors(mChunks.GetNumChunks());
+
+	mDirtyTiles = DirtyTileRanges(gameBoard.GetNumTiles());
+}
+
+void
+GLBoardRenderer::SetTileType(int tileID, ResourceType type)
+{
+	assert(type < ResourceType::NUMTYPES);
+	const auto slot = mChunks.GetTileSlot(tileID);
+	mTiles[slot].type = static_cast<GLubyte>(type);
+	mDirtyTiles.MarkDirty(slot);
+	mImpostors.MarkChunkDirty(mChunks.GetSlotChunk(slot));
+	mNeedsRedraw = true;
+}
+
+void
+GLBoardRenderer::SetTileFlags(int tileID, GLubyte flags)
+{
+	const auto slot = mChunks.GetTileSlot(tileID);
+	if (mTiles[slot].flags == flags)
+		return;
+
+	mTiles[slot].flags = flags;
+	mDirtyTiles.MarkDirty(slot);
+	mNeedsRedraw = true;
+}
+
+void
+GLBoardRenderer::PanCamera(float dxPixels, float dyPixels)
+{
+	mCamera.Pan(dxPixels, dyPixels);
+	mNeedsRedraw = true;
+}
+
+void
+GLBoardRenderer::ZoomCamera(float factor)
+{
+	double mouseX = 0.0;
+	double mouseY = 0.0;
+
+	glfwGetCursorPos(mWindow, &mouseX, &mouseY);
+	mCamera.ZoomAt(factor, mouseX, WINDOW_HEIGHT - mouseY);
+	mNeedsRedraw = true;
+}
+
+const Camera&
+GLBoardRenderer::GetCamera() const
+{
+	return mCamera;
+}
+
+void
+GLBoardRenderer::SetDrawPath(HexDrawPath drawPath)
+{
+	mDrawPath = drawPath;
+	mNeedsRedraw = true;
+	const auto& pipeline = mPipelines[static_cast<int>(mDrawPath)];
+	glUseProgram(pipeline.mProgram);
+	glBindVertexArray(pipeline.mVertexArray);
+}
+
+HexDrawPath
+GLBoardRenderer::GetDrawPath() const
+{
+	return mDrawPath;
+}
+
+void
+GLBoardRenderer::BenchmarkDrawPaths(int numFrames)
+{
+	//glFinish after every frame so the time covers the GPU work, not just submitting it
+	const char* pathNames[] = { "geometry shader", "instanced" };
+	const auto startPath = mDrawPath;
+	for (int path = 0; path < static_cast<int>(HexDrawPath::NUMPATHS); ++path)
+	{
+		SetDrawPath(static_cast<HexDrawPath>(path));
+		RenderPass();
+		glFinish();
+
+		const auto start = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < numFrames; ++frame)
+		{
+			RenderPass();
+			glFinish();
+		}
+
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+		std::cout << mLastDrawnTiles << " of " << mTiles.size() << " tiles, " << pathNames[path] << ": "
+			<< elapsed.count() / std::max(1, numFrames) << " ms per frame" << std::endl;
+	}
+
+	SetDrawPath(startPath);
+}
+
+void
+GLBoardRenderer::SetupTexture(const RendererAssets& assets)
+{
+	mOutlineTexture = CreateTexture(assets.mOutlineWidth, assets.mOutlineHeight, assets.mOutlinePixels);
+	BindTexture(GL_TEXTURE0, mOutlineTexture);
+	for (const auto& pipeline : mPipelines)
+	{
+		glUseProgram(pipeline.mProgram);
+		glUniform1i(glGetUniformLocation(pipeline.mProgram, "tileOutlineTex"), 0);
+	}
+}
+
+void
+GLBoardRenderer::SetupLayoutUniforms()
+{
+	//tiles arrive as axial coords and type indices, the shaders turn them into
+	// a position and a color with these
+	GLfloat palette[MAX_PALETTE_SIZE][3] = {};
+	for (int type = 0; type < static_cast<int>(ResourceType::NUMTYPES); ++type)
+	{
+		const auto color = TilePalette::GetColor(static_cast<ResourceType>(type));
+		palette[type][0] = color.r;
+		palette[type][1] = color.g;
+		palette[type][2] = color.b;
+	}
+
+	//world distance between neighboring columns, and between rows
+	const GLfloat hexSpacing[] = { HexLayout::HEX_WIDTH, 0.75f * HexLayout::HEX_HEIGHT };
+
+	for (const auto& pipeline : mPipelines)
+	{
+		const GLuint programs[] = { pipeline.mProgram, pipeline.mPickProgram };
+		for (const auto program : programs)
+		{
+			glUseProgram(program);
+			glUniform2fv(glGetUniformLocation(program, "hexSpacing"), 1, hexSpacing);
+			glUniform3fv(glGetUniformLocation(program, "palette"), MAX_PALETTE_SIZE, &palette[0][0]);
+		}
+	}
+
+	glUseProgram(mImpostorProgram);
+	glUniform3fv(glGetUniformLocation(mImpostorProgram, "palette"), MAX_PALETTE_SIZE, &palette[0][0]);
+}
+
+void
+GLBoardRenderer::SetupImpostors()
+{
+	//room for every chunk's block of tile types, filled in the first time impostors are drawn
+	const int numRows = std::max(1, (mChunks.GetNumChunks() + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS);
+	glGenTextures(1, &mImpostorAtlas);
+	glActiveTexture(IMPOSTOR_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, mImpostorAtlas);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, ATLAS_COLUMNS * ChunkImpostors::IMPOSTOR_SIZE, numRows * ChunkImpostors::IMPOSTOR_SIZE,
+		0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, nullptr);
+	glActiveTexture(GL_TEXTURE0);
+
+	glUseProgram(mImpostorProgram);
+	glUniform1i(glGetUniformLocation(mImpostorProgram, "impostorAtlas"), IMPOSTOR_TEXTURE_UNIT - GL_TEXTURE0);
+	glUniform1i(glGetUniformLocation(mImpostorProgram, "atlasColumns"), ATLAS_COLUMNS);
+}
+
+int
+GLBoardRenderer::DoPick()
+{
+	double mouseX = 0.0;
+	double mouseY = 0.0;
+
+	glfwGetCursorPos(mWindow, &mouseX, &mouseY);
+	return PickTile(mouseX, WINDOW_HEIGHT - mouseY);
+}
+
+int
+GLBoardRenderer::PickTile(double windowX, double windowY) const
+{
+	//undo the camera's transform and find the hex under that point
+	float x, y;
+	mCamera.WindowToWorld(x, y, windowX, windowY);
+
+	AxialCoord position;
+	if (!HexLayout::PickHex(x, y, position) || !mTileIndex.IsPositionValid(position))
+		return INT_MAX;
+
+	return mTileIndex.GetTileIndex(position);
+}
+
+int  
+GLBoardRenderer::DoPickGL()
+{
+	//debug fallback: pick the pixel under the mouse out of the tile ID buffer.
+	//This stalls until the GPU has finished drawing
+	double mouseX = 0.0;
+	double mouseY = 0.0;
+
+	glfwGetCursorPos(mWindow, &mouseX, &mouseY);
+	mouseY = WINDOW_HEIGHT - mouseY;
+
+	const auto pickedTiles = PickTilesInRect(static_cast<int>(mouseX), static_cast<int>(mouseY), 1, 1);
+	if (pickedTiles.empty())
+		return INT_MAX;
+
+	return *pickedTiles.begin();
+}
+
+void
+GLBoardRenderer::RequestPickRect(int x, int y, int width, int height)
+{
+	//only the part of the rectangle inside the window can be read back
+	const int x1 = std::min(x + width, static_cast<int>(WINDOW_WIDTH));
+	const int y1 = std::min(y + height, static_cast<int>(WINDOW_HEIGHT));
+	x = std::max(x, 0);
+	y = std::max(y, 0);
+	width = std::max(x1 - x, 0);
+	height = std::max(y1 - y, 0);
+
+	RenderPickPass(x, y, width, height);
+}
+
+bool
+GLBoardRenderer::GetPickRectResult(TileIDSet& pickedTiles)
+{
+	//returns false while the readback is still in flight
+	if (mPickFence == nullptr)
+		return false;
+
+	if (glClientWaitSync(mPickFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+		return false;
+
+	ReadPickPixels(pickedTiles);
+	return true;
+}
+
+TileIDSet
+GLBoardRenderer::PickTilesInRect(int x, int y, int width, int height)
+{
+	//box selection: every tile with at least one pixel inside the rectangle
+	RequestPickRect(x, y, width, height);
+
+	const GLuint64 waitNanoseconds = 1000000000;
+	glClientWaitSync(mPickFence, GL_SYNC_FLUSH_COMMANDS_BIT, waitNanoseconds);
+
+	TileIDSet pickedTiles;
+	ReadPickPixels(pickedTiles);
+	return pickedTiles;
+}
+
+void
+GLBoardRenderer::RenderPickPass(int x, int y, int width, int height)
+{
+	//draw tile IDs into the offscreen buffer, only inside the rectangle being picked
+	const auto& pipeline = mPipelines[static_cast<int>(mDrawPath)];
+	glBindFramebuffer(GL_FRAMEBUFFER, mPickFramebuffer);
+	glUseProgram(pipeline.mPickProgram);
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(x, y, width, height);
+
+	const GLuint noTile[] = { 0, 0, 0, 0 };
+	glClearBufferuiv(GL_COLOR, 0, noTile);
+
+	UploadDirtyTiles();
+	DrawTiles(pipeline.mPickViewProjectionUniform, pipeline.mPickTileBaseUniform);
+	glDisable(GL_SCISSOR_TEST);
+
+	//copy the rectangle into the pixel buffer. This returns right away, the
+	// fence tells us when the copy has landed
+	mPickPixelCount = width * height;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, mPickPixelBuffer);
+	glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint) * mPickPixelCount, nullptr, GL_STREAM_READ);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glReadPixels(x, y, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (mPickFence != nullptr)
+		glDeleteSync(mPickFence);
+	mPickFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glUseProgram(pipeline.mProgram);
+}
+
+void
+GLBoardRenderer::ReadPickPixels(TileIDSet& pickedTiles)
+{
+	glDeleteSync(mPickFence);
+	mPickFence = nullptr;
+
+	if (mPickPixelCount == 0)
+		return;
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, mPickPixelBuffer);
+	const auto pickIDs = static_cast<const GLuint*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint) * mPickPixelCount, GL_MAP_READ_BIT));
+	if (pickIDs != nullptr)
+	{
+		//neighboring pixels are almost always the same tile, skip repeats before hashing
+		GLuint lastID = 0;
+		for (int pixel = 0; pixel < mPickPixelCount; ++pixel)
+		{
+			const auto pickID = pickIDs[pixel];
+			if (pickID != 0 && pickID != lastID)
+				pickedTiles.insert(mChunks.GetSlotTile(static_cast<int>(pickID) - 1));
+			lastID = pickID;
+		}
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+GLuint 
+GLBoardRenderer::CreateTexture(int width, int height, const std::vector<unsigned char>& pixels) const
+{
+	assert(pixels.size() == static_cast<size_t>(4 * width * height));
+	GLuint texture = 0;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	return texture;
+}
+
+void 
+GLBoardRenderer::BindTexture(GLenum TextureUnit, GLuint tex) const
+{
+	glActiveTexture(TextureUnit);
+	glBindTexture(GL_TEXTURE_2D, tex);
+}
+
+bool 
+GLBoardRenderer::CheckShader(const GLuint& shader) const
+{
+	GLint isCompiled = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+	if (isCompiled == GL_FALSE)
+	{
+		GLint maxLength = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+		std::vector<GLchar> errorLog(maxLength);
+		glGetShaderInfoLog(shader, maxLength, &maxLength, &errorLog[0]);
+		for (auto c : errorLog)
+			std::cout << c;
+		glDeleteShader(shader); // Don't leak the shader.
+		return false;
+	}
+
+	return true;
+}
+
+GLuint
+GLBoardRenderer::GetShader(const RendererAssets& assets, GLenum shaderType, const char* filename)
+{
+	auto& shader = mShaders[filename];
+	if (shader == 0)
+		shader = CompileShader(shaderType, assets.mShaderSources.at(filename));
+	return shader;
+}
+
+GLuint
+GLBoardRenderer::CompileShader(GLenum shaderType, const std::string& source) const
+{
+	const GLchar* sourcePtr = source.c_str();
+
+	GLuint shader = glCreateShader(shaderType);
+	glShaderSource(shader, 1, &sourcePtr, NULL);
+	glCompileShader(shader);
+	CheckShader(shader);
+
+	return shader;
+}
+
+void
+GLBoardRenderer::LinkProgram(GLuint program) const
+{
+	glLinkProgram(program);
+
+	//check errors
+	GLint success = 0;
+	GLchar ErrorLog[1024] = { 0 };
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(program, sizeof(ErrorLog), NULL, ErrorLog);
+		fprintf(stderr, "Error linking shader program: '%s'\n", ErrorLog);
+		exit(EXIT_FAILURE);
+	}
+
+	glValidateProgram(program);
+	glGetProgramiv(program, GL_VALIDATE_STATUS, &success);
+	if (!success)
+	{
+		glGetProgramInfoLog(program, sizeof(ErrorLog), NULL, ErrorLog);
+		fprintf(stderr, "Invalid shader program: '%s'\n", ErrorLog);
+		exit(EXIT_FAILURE);
+	}
+}
+
+GLuint
+GLBoardRenderer::CreateProgram(const RendererAssets& assets, const char* vertexFile, const char* geometryFile, const char* fragmentFile, const char* fragOutput)
+{
+	//the driver is in the key too, an update can change what a binary means
+	const auto key = ProgramCache::HashParts({
+		reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+		reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+		reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+		PROGRAM_CACHE_LAYOUT,
+		assets.mShaderSources.at(vertexFile),
+		geometryFile != nullptr ? assets.mShaderSources.at(geometryFile) : std::string(),
+		assets.mShaderSources.at(fragmentFile),
+		fragOutput });
+
+	GLuint program = glCreateProgram();
+	if (LoadCachedProgram(program, key))
+	{
+		mNumCachedPrograms++;
+		return program;
+	}
+
+	glAttachShader(program, GetShader(assets, GL_VERTEX_SHADER, vertexFile));
+	if (geometryFile != nullptr)
+		glAttachShader(program, GetShader(assets, GL_GEOMETRY_SHADER, geometryFile));
+	glAttachShader(program, GetShader(assets, GL_FRAGMENT_SHADER, fragmentFile));
+
+	//names a program doesn't use are ignored, so every program gets the same slots
+	glBindAttribLocation(program, AXIAL_ATTRIB, "axial");
+	glBindAttribLocation(program, TYPE_AND_FLAGS_ATTRIB, "typeAndFlags");
+	glBindAttribLocation(program, CORNER_ATTRIB, "corner");
+	glBindAttribLocation(program, CORNER_TEXCOORD_ATTRIB, "cornerTexcoord");
+	glBindAttribLocation(program, CHUNK_BOUNDS_ATTRIB, "chunkBounds");
+	glBindFragDataLocation(program, 0, fragOutput);
+	if (mProgramCache.IsEnabled() && (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	LinkProgram(program);
+	mNumLinkedPrograms++;
+
+	StoreCachedProgram(program, key);
+	return program;
+}
+
+bool
+GLBoardRenderer::LoadCachedProgram(GLuint program, std::uint64_t key) const
+{
+	if (!(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+		return false;
+
+	std::uint32_t format = 0;
+	std::vector<char> binary;
+	if (!mProgramCache.Load(key, format, binary))
+		return false;
+
+	//a driver can turn down its own binaries, then the program is built from source as usual
+	glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size()));
+	GLint success = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	return success != 0;
+}
+
+void
+GLBoardRenderer::StoreCachedProgram(GLuint program, std::uint64_t key) const
+{
+	if (!mProgramCache.IsEnabled() || !(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+		return;
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &length, &format, binary.data());
+	binary.resize(length);
+	if (!mProgramCache.Store(key, format, binary))
+		fprintf(stderr, "Couldn't write '%s'\n", mProgramCache.GetPath(key).c_str());
+}
+
+void 
+GLBoardRenderer::SetupShaders(const RendererAssets& assets)
+{
+	mNumCachedPrograms = 0;
+	mNumLinkedPrograms = 0;
+
+	//both paths share the fragment shaders, the pick one writes the tile ID instead of a color
+	const char* vertexFiles[static_cast<int>(HexDrawPath::NUMPATHS)] = { "vert.glsl", "hexvert.glsl" };
+	const char* geometryFiles[static_cast<int>(HexDrawPath::NUMPATHS)] = { "geo.glsl", nullptr };
+
+	for (int path = 0; path < static_cast<int>(HexDrawPath::NUMPATHS); ++path)
+	{
+		auto& pipeline = mPipelines[path];
+		pipeline.mProgram = CreateProgram(assets, vertexFiles[path], geometryFiles[path], "frag.glsl", "outColor");
+		pipeline.mPickProgram = CreateProgram(assets, vertexFiles[path], geometryFiles[path], "pickfrag.glsl", "pickID");
+		pipeline.mViewProjectionUniform = glGetUniformLocation(pipeline.mProgram, "viewProjection");
+		pipeline.mPickViewProjectionUniform = glGetUniformLocation(pipeline.mPickProgram, "viewProjection");
+		pipeline.mPickTileBaseUniform = glGetUniformLocation(pipeline.mPickProgram, "tileBase");
+	}
+
+	mImpostorProgram = CreateProgram(assets, "impostorvert.glsl", nullptr, "impostorfrag.glsl", "fragColor");
+	mImpostorViewProjectionUniform = glGetUniformLocation(mImpostorProgram, "viewProjection");
+
+	//linked programs keep what they need, the shaders can go
+	for (const auto& shader : mShaders)
+		glDeleteShader(shader.second);
+	mShaders.clear();
+}
+
+void 
+GLBoardRenderer::SetupBuffers()
+{
+	// One packed record per tile, both paths read it
+	glGenBuffers(1, &mTileBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mTileBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(PackedTile)*mTiles.size(), mTiles.data(), GL_DYNAMIC_DRAW);
+
+	// The one hex every instance is drawn from: corner offset then outline tex coord
+	GLfloat hexMesh[NUM_HEX_CORNERS][4];
+	for (int corner = 0; corner < NUM_HEX_CORNERS; ++corner)
+	{
+		HexLayout::GetHexCorner(hexMesh[corner][0], hexMesh[corner][1], corner);
+		hexMesh[corner][2] = HEX_CORNER_TEXCOORDS[corner][0];
+		hexMesh[corner][3] = HEX_CORNER_TEXCOORDS[corner][1];
+	}
+
+	glGenBuffers(1, &mHexMeshBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mHexMeshBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(hexMesh), hexMesh, GL_STATIC_DRAW);
+
+	// A unit quad in triangle strip order and every chunk's bounds, for the impostors
+	const GLfloat impostorQuad[] = { 0.f, 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 1.f };
+	glGenBuffers(1, &mImpostorQuadBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mImpostorQuadBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(impostorQuad), impostorQuad, GL_STATIC_DRAW);
+
+	std::vector<GLfloat> chunkBounds;
+	for (int chunkIndex = 0; chunkIndex < mChunks.GetNumChunks(); ++chunkIndex)
+	{
+		const auto& bounds = mChunks.GetChunk(chunkIndex).mBounds;
+		chunkBounds.insert(chunkBounds.end(), { bounds.mMinX, bounds.mMinY, bounds.mMaxX, bounds.mMaxY });
+	}
+
+	glGenBuffers(1, &mChunkBoundsBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, mChunkBoundsBuffer);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*chunkBounds.size(), chunkBounds.data(), GL_STATIC_DRAW);
+}
+
+void
+GLBoardRenderer::SetupPickBuffers()
+{
+	//a 32 bit unsigned ID per pixel, so picking works for any number of tiles
+	glGenRenderbuffers(1, &mPickIDRenderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, mPickIDRenderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_R32UI, static_cast<GLsizei>(WINDOW_WIDTH), static_cast<GLsizei>(WINDOW_HEIGHT));
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &mPickFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, mPickFramebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mPickIDRenderbuffer);
+	assert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	glGenBuffers(1, &mPickPixelBuffer);
+}
+
+void 
+GLBoardRenderer::SetupVertexArrays()
+{
+	// Geometry shader path: one point per tile record
+	glGenVertexArrays(1, &mPipelines[static_cast<int>(HexDrawPath::GEOMETRY_SHADER)].mVertexArray);
+	glBindVertexArray(mPipelines[static_cast<int>(HexDrawPath::GEOMETRY_SHADER)].mVertexArray);
+	SetTileAttribs(0, 0);
+
+	// Instanced path: the hex mesh per vertex, the same tile records per instance
+	glGenVertexArrays(1, &mPipelines[static_cast<int>(HexDrawPath::INSTANCED)].mVertexArray);
+	glBindVertexArray(mPipelines[static_cast<int>(HexDrawPath::INSTANCED)].mVertexArray);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mHexMeshBuffer);
+	glEnableVertexAttribArray(CORNER_ATTRIB);
+	glVertexAttribPointer(CORNER_ATTRIB, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+	glEnableVertexAttribArray(CORNER_TEXCOORD_ATTRIB);
+	glVertexAttribPointer(CORNER_TEXCOORD_ATTRIB, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), reinterpret_cast<const GLvoid*>(2 * sizeof(GLfloat)));
+
+	SetTileAttribs(1, 0);
+
+	// Impostors: the unit quad per vertex, a chunk's bounds per instance
+	glGenVertexArrays(1, &mImpostorVertexArray);
+	glBindVertexArray(mImpostorVertexArray);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mImpostorQuadBuffer);
+	glEnableVertexAttribArray(CORNER_ATTRIB);
+	glVertexAttribPointer(CORNER_ATTRIB, 2, GL_FLOAT, GL_FALSE, 0, 0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mChunkBoundsBuffer);
+	glEnableVertexAttribArray(CHUNK_BOUNDS_ATTRIB);
+	glVertexAttribPointer(CHUNK_BOUNDS_ATTRIB, 4, GL_FLOAT, GL_FALSE, 0, 0);
+	glVertexAttribDivisor(CHUNK_BOUNDS_ATTRIB, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void
+GLBoardRenderer::SetTileAttribs(GLuint divisor, int firstSlot) const
+{
+	//integer attributes starting at firstSlot, the shaders do the unpacking.
+	//Expects the vertex array being set up to be bound
+	const auto firstByte = sizeof(PackedTile) * firstSlot;
+	glBindBuffer(GL_ARRAY_BUFFER, mTileBuffer);
+	glEnableVertexAttribArray(AXIAL_ATTRIB);
+	glVertexAttribIPointer(AXIAL_ATTRIB, 2, GL_SHORT, sizeof(PackedTile), reinterpret_cast<const GLvoid*>(firstByte + offsetof(PackedTile, r)));
+	glVertexAttribDivisor(AXIAL_ATTRIB, divisor);
+
+	glEnableVertexAttribArray(TYPE_AND_FLAGS_ATTRIB);
+	glVertexAttribIPointer(TYPE_AND_FLAGS_ATTRIB, 2, GL_UNSIGNED_BYTE, sizeof(PackedTile), reinterpret_cast<const GLvoid*>(firstByte + offsetof(PackedTile, type)));
+	glVertexAttribDivisor(TYPE_AND_FLAGS_ATTRIB, divisor);
+}
+
+void 
+GLBoardRenderer::RenderPass()
+{
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	UploadDirtyTiles();
+	if (ChunkImpostors::ShouldDraw(mCamera.GetPixelsPerWorldUnit()))
+		DrawImpostors();
+	else
+		DrawTiles(mPipelines[static_cast<int>(mDrawPath)].mViewProjectionUniform, -1);
+}
+
+void
+GLBoardRenderer::DrawImpostors()
+{
+	//this far out most of the board is in view, so every chunk's quad is drawn
+	// and clipping takes care of the rest
+	UploadDirtyImpostors();
+
+	GLfloat viewProjection[16];
+	mCamera.GetViewProjection(viewProjection);
+	glUseProgram(mImpostorProgram);
+	glUniformMatrix4fv(mImpostorViewProjectionUniform, 1, GL_FALSE, viewProjection);
+
+	glBindVertexArray(mImpostorVertexArray);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, mChunks.GetNumChunks());
+
+	glUseProgram(mPipelines[static_cast<int>(mDrawPath)].mProgram);
+	mLastDrawnTiles = 0;
+}
+
+void
+GLBoardRenderer::UploadDirtyImpostors()
+{
+	//only chunks with a tile that changed type since they were last built are redone
+	if (!mImpostors.AnyDirty())
+		return;
+
+	mImpostors.UpdateDirty(mChunks, mTileIndex, &mTiles[0].type, sizeof(PackedTile), mRebuiltChunks);
+
+	glActiveTexture(IMPOSTOR_TEXTURE_UNIT);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (const auto chunkIndex : mRebuiltChunks)
+	{
+		glTexSubImage2D(GL_TEXTURE_2D, 0,
+			(chunkIndex % ATLAS_COLUMNS) * ChunkImpostors::IMPOSTOR_SIZE, (chunkIndex / ATLAS_COLUMNS) * ChunkImpostors::IMPOSTOR_SIZE,
+			ChunkImpostors::IMPOSTOR_SIZE, ChunkImpostors::IMPOSTOR_SIZE, GL_RED_INTEGER, GL_UNSIGNED_BYTE, mImpostors.GetTexels(chunkIndex));
+	}
+	glActiveTexture(GL_TEXTURE0);
+}
+
+void
+GLBoardRenderer::UpdateVisibleTiles()
+{
+	mChunks.FindVisibleSlots(mCamera.GetViewBounds(), mVisibleSlots);
+
+	mLastDrawnTiles = 0;
+	for (const auto& range : mVisibleSlots)
+		mLastDrawnTiles += range.mEnd - range.mBegin;
+}
+
+void
+GLBoardRenderer::DrawTiles(GLint viewProjectionUniform, GLint tileBaseUniform)
+{
+	//expects the current path's program to be in use. Only the chunks in view
+	// are drawn, one call per run of neighboring chunks
+	GLfloat viewProjection[16];
+	mCamera.GetViewProjection(viewProjection);
+	glUniformMatrix4fv(viewProjectionUniform, 1, GL_FALSE, viewProjection);
+
+	UpdateVisibleTiles();
+	glBindVertexArray(mPipelines[static_cast<int>(mDrawPath)].mVertexArray);
+	for (const auto& range : mVisibleSlots)
+	{
+		//gl_InstanceID and gl_PrimitiveIDIn count from 0 in every call, the pick
+		// shaders add tileBase to get back to the slot
+		const auto numTiles = range.mEnd - range.mBegin;
+		glUniform1i(tileBaseUniform, range.mBegin);
+		if (mDrawPath == HexDrawPath::INSTANCED)
+		{
+			SetTileAttribs(1, range.mBegin);
+			glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, NUM_HEX_CORNERS, numTiles);
+		}
+		else
+		{
+			glDrawArrays(GL_POINTS, range.mBegin, numTiles);
+		}
+	}
+}
+
+void
+GLBoardRenderer::UploadDirtyTiles()
+{
+	//the buffer keeps its storage from SetupBuffers, changed runs are written
+	// over in place. Runs less than a few tiles apart go up as one call
+	const int maxUploadGap = 16;
+	mLastUploadBytes = 0;
+	if (!mDirtyTiles.Any())
+		return;
+
+	mDirtyTiles.TakeRanges(maxUploadGap, mUploadRanges);
+
+	glBindBuffer(GL_ARRAY_BUFFER, mTileBuffer);
+	for (const auto& range : mUploadRanges)
+	{
+		const auto numBytes = sizeof(PackedTile) * (range.mEnd - range.mBegin);
+		glBufferSubData(GL_ARRAY_BUFFER, sizeof(PackedTile) * range.mBegin, numBytes, &mTiles[range.mBegin]);
+		mLastUploadBytes += static_cast<int>(numBytes);
+	}
+}
+
+int
+GLBoardRenderer::GetLastUploadBytes() const
+{
+	return mLastUploadBytes;
+}
+
+int
+GLBoardRenderer::GetLastDrawnTiles() const
+{
+	return mLastDrawnTiles;
+}
+
+int
+GLBoardRenderer::GetNumCachedPrograms() const
+{
+	return mNumCachedPrograms;
+}
+
+int
+GLBoardRenderer::GetNumLinkedPrograms() const
+{
+	return mNumLinkedPrograms;
+}
+
+void 
+GLBoardRenderer::Cleanup()
+{
+	for (const auto& pipeline : mPipelines)
+	{
+		glDeleteProgram(pipeline.mProgram);
+		glDeleteProgram(pipeline.mPickProgram);
+		glDeleteVertexArrays(1, &pipeline.mVertexArray);
+	}
+	glDeleteProgram(mImpostorProgram);
+	glDeleteVertexArrays(1, &mImpostorVertexArray);
+	glDeleteTextures(1, &mImpostorAtlas);
+	glDeleteTextures(1, &mOutlineTexture);
+
+	glDeleteBuffers(1, &mTileBuffer);
+	glDeleteBuffers(1, &mHexMeshBuffer);
+	glDeleteBuffers(1, &mImpostorQuadBuffer);
+	glDeleteBuffers(1, &mChunkBoundsBuffer);
+	glDeleteBuffers(1, &mPickPixelBuffer);
+	glDeleteFramebuffers(1, &mPickFramebuffer);
+	glDeleteRenderbuffers(1, &mPickIDRenderbuffer);
+	if (mPickFence != nullptr)
+		glDeleteSync(mPickFence);
+}
+
+void
+GLBoardRenderer::SetSelection(const AxialCoord& position)
+{
+	//update the selected tile/outline texture by moving the flag from the old
+	// selected tile to the new one
+	if (mSelectedTile >= 0)
+		SetTileFlags(mSelectedTile, static_cast<GLubyte>(mTiles[mChunks.GetTileSlot(mSelectedTile)].flags & ~TILE_FLAG_SELECTED));
+
+	mSelectedTile = mTileIndex.IsPositionValid(position) ? mTileIndex.GetTileIndex(position) : -1;
+	if (mSelectedTile >= 0)
+		SetTileFlags(mSelectedTile, static_cast<GLubyte>(mTiles[mChunks.GetTileSlot(mSelectedTile)].flags | TILE_FLAG_SELECTED));
+}
+
+void 
+GLBoardRenderer::RenderScene()
+{
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	RenderPass();
+
+	glfwSwapBuffers(mWindow);
+	mNeedsRedraw = false;
+}
+
+void
+GLBoardRenderer::RunFrame(FramePacer::Clock::time_point nextDeadline)
+{
+	auto now = FramePacer::Clock::now();
+	if (mNeedsRedraw && mFramePacer.CanDrawFrame(now))
+	{
+		RenderScene();
+		mFramePacer.OnFrameDrawn(now);
+		now = FramePacer::Clock::now();
+	}
+
+	WaitForEvents(mFramePacer.GetWaitSeconds(now, mNeedsRedraw, nextDeadline));
+}
+
+void
+GLBoardRenderer::WaitForEvents(double timeoutSeconds) const
+{
+	//input callbacks run in here, anything they change asks for a redraw
+	if (timeoutSeconds <= 0.0)
+		glfwPollEvents();
+	else if (std::isinf(timeoutSeconds))
+		glfwWaitEvents();
+	else
+		glfwWaitEventsTimeout(timeoutSeconds);
+}
+
+void
+GLBoardRenderer::RequestRedraw()
+{
+	mNeedsRedraw = true;
+}
+
+bool
+GLBoardRenderer::NeedsRedraw() const
+{
+	return mNeedsRedraw;
+}
+
+void
+GLBoardRenderer::SetMaxFramesPerSecond(double maxFramesPerSecond)
+{
+	mFramePacer.SetMaxFramesPerSecond(maxFramesPerSecond);
+}
+
+void
+GLBoardRenderer::SetVSync(bool enabled)
+{
+	glfwSwapInterval(enabled ? 1 : 0);
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BoardChunks.h"
+#include "BoardRenderer.h"
+#include "Camera.h"
+#include "ChunkImpostors.h"
+#include "DirtyTileRanges.h"
+#include "FramePacer.h"
+#include "ProgramCache.h"
+#include "TileBitSet.h"
+#include "TileRanges.h"
+#include "TileTraits.h"
+
+class Board;
+
+//GLsync is a pointer to this, declared here so the header doesn't need GLEW
+struct __GLsync;
+
+//everything the GPU is sent about one tile. The shaders place it from the
+// axial coord and color it from a palette indexed by type
+struct PackedTile
+{
+	GLshort r, q;
+	GLubyte type;	//a ResourceType
+	GLubyte flags;	//see TILE_FLAG_SELECTED
+};
+
+//how the hexes get built on the GPU
+enum class HexDrawPath
+{
+	GEOMETRY_SHADER,	//one point per tile, expanded to a hex by geo.glsl
+	INSTANCED,			//one shared hex mesh drawn once per tile
+	NUMPATHS
+};
+
+//everything Init reads from disk. None of it needs a GL context, so it can be
+// loaded on another thread while the window is being made
+struct RendererAssets
+{
+	std::map<std::string, std::string> mShaderSources;	//by file name
+
+	//the selection outline, RGBA with the bottom row first the way GL wants it
+	int mOutlineWidth;
+	int mOutlineHeight;
+	std::vector<unsigned char> mOutlinePixels;
+
+	RendererAssets() : mOutlineWidth(0), mOutlineHeight(0) { }
+};
+
+class GLBoardRenderer : public BoardRenderer
+{
+
+public:
+	GLBoardRenderer(GLFWwindow*, int, int);
+
+	//reads and decodes the shader and texture files, safe to call from any thread.
+	// Throws std::runtime_error naming the file if one can't be loaded
+	static RendererAssets LoadAssets();
+
+	//Init loads the assets itself, the other takes ones loaded ahead of time
+	void Init() override;
+	void Init(const RendererAssets& assets);
+
+	void SetupTiles(const Board& gameBoard) override;
+	void SetSelection(const AxialCoord& position) override;
+	void SetTileType(int tileID, ResourceType type) override;
+
+	void PanCamera(float dxPixels, float dyPixels) override;
+	void ZoomCamera(float factor) override;
+	const Camera& GetCamera() const;
+
+	void SetDrawPath(HexDrawPath drawPath);
+	HexDrawPath GetDrawPath() const;
+
+	//draws numFrames frames with each path and prints the average frame time
+	void BenchmarkDrawPaths(int numFrames);
+
+	int DoPick() override;
+	int DoPickGL();
+	int PickTile(double windowX, double windowY) const;
+
+	//GPU picks of a window rectangle, y measured up from the bottom. The request
+	// renders tile IDs and starts an asynchronous readback, the result can be
+	// collected a frame or so later without stalling
+	void RequestPickRect(int x, int y, int width, int height);
+	bool GetPickRectResult(TileIDSet& pickedTiles);
+	TileIDSet PickTilesInRect(int x, int y, int width, int height);
+
+	void RenderScene() override;
+
+	//sleeps in glfwWaitEventsTimeout until input, the next frame slot allowed by
+	// the frame cap, or nextDeadline
+	void RunFrame(FramePacer::Clock::time_point nextDeadline) override;
+	void RequestRedraw() override;
+	bool NeedsRedraw() const override;
+
+	//0 for no cap
+	void SetMaxFramesPerSecond(double maxFramesPerSecond);
+	void SetVSync(bool enabled);
+
+	void Cleanup() override;
+
+	//bytes of tile data sent to the GPU by the last frame
+	int GetLastUploadBytes() const;
+
+	//tiles in the chunks the last frame drew, the rest were culled. 0 when the
+	// frame was zoomed out far enough to draw chunk impostors instead
+	int GetLastDrawnTiles() const;
+
+	//programs the last Init got from the program cache, and ones it had to link
+	int GetNumCachedPrograms() const;
+	int GetNumLinkedPrograms() const;
+
+private:
+	void SetupBuffers();
+	void SetupPickBuffers();
+	void SetupShaders(const RendererAssets& assets);
+	void SetupVertexArrays();
+	void SetTileAttribs(GLuint divisor, int firstSlot) const;
+	void SetupTexture(const RendererAssets& assets);
+	void SetupLayoutUniforms();
+	void SetupImpostors();
+
+	GLuint GetShader(const RendererAssets& assets, GLenum shaderType, const char* filename);
+	GLuint CompileShader(GLenum shaderType, const std::string& source) const;
+	GLuint CreateProgram(const RendererAssets& assets, const char* vertexFile, const char* geometryFile, const char* fragmentFile, const char* fragOutput);
+	bool LoadCachedProgram(GLuint program, std::uint64_t key) const;
+	void StoreCachedProgram(GLuint program, std::uint64_t key) const;
+	void LinkProgram(GLuint program) const;
+
+	GLuint CreateTexture(int width, int height, const std::vector<unsigned char>& pixels) const;
+	void BindTexture(GLenum TextureUnit, GLuint tex) const;
+
+	bool CheckShader(const GLuint& shader) const;
+
+	void RenderPass();
+	void UpdateVisibleTiles();
+	void DrawTiles(GLint viewProjectionUniform, GLint tileBaseUniform);
+	void DrawImpostors();
+	void UploadDirtyImpostors();
+	void UploadDirtyTiles();
+	void SetTileFlags(int tileID, GLubyte flags);
+	void RenderPickPass(int x, int y, int width, int height);
+	void ReadPickPixels(TileIDSet& pickedTiles);
+	void WaitForEvents(double timeoutSeconds) const;
+
+	GLFWwindow* mWindow;
+	const float WINDOW_WIDTH;
+	const float WINDOW_HEIGHT;
+
+	//everything needed to draw the board one way: shaders, the color and tile ID
+	// programs built from them, and the attribute bindings
+	struct HexPipeline
+	{
+		GLuint mProgram;
+		GLuint mPickProgram;
+		GLuint mVertexArray;
+		GLint mViewProjectionUniform;
+		GLint mPickViewProjectionUniform;
+		GLint mPickTileBaseUniform;
+
+		HexPipeline() : mProgram(0), mPickProgram(0), mVertexArray(0)
+			, mViewProjectionUniform(-1), mPickViewProjectionUniform(-1), mPickTileBaseUniform(-1) { }
+	};
+
+	HexPipeline mPipelines[static_cast<int>(HexDrawPath::NUMPATHS)];
+	HexDrawPath mDrawPath;
+
+	//shaders by file name, only compiled when a program they're in wasn't in
+	// the program cache
+	std::map<std::string, GLuint> mShaders;
+	ProgramCache mProgramCache;
+	int mNumCachedPrograms;
+	int mNumLinkedPrograms;
+
+	GLuint mTileBuffer;
+	GLuint mHexMeshBuffer;
+
+	//zoomed out, each chunk is one quad textured from its block of mImpostorAtlas
+	GLuint mImpostorProgram;
+	GLuint mImpostorVertexArray;
+	GLuint mImpostorQuadBuffer;
+	GLuint mChunkBoundsBuffer;
+	GLuint mImpostorAtlas;
+	GLuint mOutlineTexture;
+	GLint mImpostorViewProjectionUniform;
+
+	//offscreen target holding one unsigned tile ID + 1 per pixel, and the
+	// pixel buffer the picked rectangle is copied into
+	GLuint mPickFramebuffer;
+	GLuint mPickIDRenderbuffer;
+	GLuint mPickPixelBuffer;
+	__GLsync* mPickFence;
+	int mPickPixelCount;
+
+	//one record per draw slot, see BoardChunks
+	std::vector<PackedTile> mTiles;
+	int mSelectedTile;
+
+	Camera mCamera;
+	BoardChunks mChunks;
+	TileSlotRangeList mVisibleSlots;
+	int mLastDrawnTiles;
+
+	ChunkImpostors mImpostors;
+	std::vector<int> mRebuiltChunks;
+
+	FramePacer mFramePacer;
+	bool mNeedsRedraw;
+
+	//tiles whose type or flags changed since the last frame, only these get re-sent
+	DirtyTileRanges mDirtyTiles;
+	DirtyTileRangeList mUploadRanges;
+	int mLastUploadBytes;
+
+	TileIndexView mTileIndex;
+};
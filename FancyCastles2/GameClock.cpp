@@ -0,0 +1,40 @@
+#include "GameClock.h"
+
+#include <cassert>
+
+GameClock::Clock::time_point
+RealGameClock::Now() const
+{
+	return Clock::now();
+}
+
+VirtualGameClock::VirtualGameClock(Clock::time_point start)
+	: mNow(start)
+{
+}
+
+GameClock::Clock::time_point
+VirtualGameClock::Now() const
+{
+	return mNow;
+}
+
+void
+VirtualGameClock::AdvanceTo(Clock::time_point time)
+{
+	if (time > mNow)
+		mNow = time;
+}
+
+void
+VirtualGameClock::AdvanceBy(Clock::duration duration)
+{
+	assert(duration >= Clock::duration::zero());
+	mNow += duration;
+}
+
+void
+VirtualGameClock::SetNow(Clock::time_point time)
+{
+	mNow = time;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+//Where game time comes from. Timers are started and finished against it, so a
+// game can run on the real clock or on one that's moved along by hand
+class GameClock
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	virtual ~GameClock() {}
+	virtual Clock::time_point Now() const = 0;
+};
+
+using GameClockPtr = std::shared_ptr < GameClock > ;
+
+class RealGameClock : public GameClock
+{
+public:
+	Clock::time_point Now() const override;
+};
+
+//only moves when told to. A headless game jumps it straight to the next timer
+// deadline instead of waiting for it
+class VirtualGameClock : public GameClock
+{
+public:
+	explicit VirtualGameClock(Clock::time_point start = Clock::time_point());
+
+	Clock::time_point Now() const override;
+
+	//never goes backwards, earlier times are ignored
+	void AdvanceTo(Clock::time_point time);
+	void AdvanceBy(Clock::duration duration);
+
+	//can go backwards, for putting a game back to a snapshot
+	void SetNow(Clock::time_point time);
+
+private:
+	Clock::time_point mNow;
+};
@@ -1,8 +1,11 @@
 #include "GameManager.h"
 
+#include <assert.h>
+
 #include "BoardController.h"
 #include "BoardRenderer.h"
 #include "Commands.h"
+#include "GameSnapshot.h"
 #include "PlayerController.h"
 #include "GameObject.h"
 #include "Timer.h"
@@ -13,17 +16,23 @@ GameManager::GameManager(BoardRendererPtr renderComponent, BoardControllerPtr bo
 	, mPlayerController(playerController)
 	, mNextObjectID(0)
 	, mCurPlayerChoosing(1)
+	, mRunGameLoop(false)
 {
 }
 
 GameManager::~GameManager()
 {
-	mRenderComponent->Cleanup();
+	if (mRenderComponent)
+		mRenderComponent->Cleanup();
 }
 
 void
 GameManager::OnNotify(Command* cmd)
 {
+	//picks are recorded once they're resolved to a tile
+	if (mRecorder && !dynamic_cast<PickSelectionCommand*>(cmd))
+		mRecorder->OnNotify(cmd);
+
 	auto moveSelectionCmd = dynamic_cast<MoveSelectionCommand*>(cmd);
 	if (moveSelectionCmd)
 	{
@@ -38,6 +47,29 @@ GameManager::OnNotify(Command* cmd)
 		return;
 	}
 
+	auto selectCmd = dynamic_cast<SelectTileCommand*>(cmd);
+	if (selectCmd)
+	{
+		SelectTile(mCurPlayerChoosing, selectCmd->GetTileID());
+		return;
+	}
+
+	auto panCmd = dynamic_cast<PanCameraCommand*>(cmd);
+	if (panCmd)
+	{
+		if (mRenderComponent)
+			mRenderComponent->PanCamera(panCmd->GetDX(), panCmd->GetDY());
+		return;
+	}
+
+	auto zoomCmd = dynamic_cast<ZoomCameraCommand*>(cmd);
+	if (zoomCmd)
+	{
+		if (mRenderComponent)
+			mRenderComponent->ZoomCamera(zoomCmd->GetFactor());
+		return;
+	}
+
 	auto harvestCmd = dynamic_cast<HarvestCommand*>(cmd);
 	if (harvestCmd)
 	{
@@ -59,8 +91,7 @@ GameManager::OnNotify(Command* cmd)
 	if (buildCmd)
 	{
 		const auto playerSelection = mBoardController->GetSelectedTileForPlayer(mCurPlayerChoosing);
-		const auto playerTiles = mPlayerController->GetPlayerTiles(mCurPlayerChoosing);
-		const auto& playerConnectedTiles = mBoardController->FindConnectedComponent(playerTiles, playerSelection);
+		const auto& playerConnectedTiles = mPlayerController->GetConnectedPlayerTiles(mCurPlayerChoosing, playerSelection);
 		const auto& availableObjects = mPlayerController->GetGameObjectsFromTiles(mCurPlayerChoosing, playerConnectedTiles);
 
 		//$TODO get requested build object from parameter bag
@@ -79,7 +110,7 @@ GameManager::OnNotify(Command* cmd)
 			return;
 
 		mCurPlayerChoosing = requestedPlayer;
-		mRenderComponent->SetSelection(mBoardController->GetSelectionCoordsForPlayer(mCurPlayerChoosing));
+		ShowSelection(mCurPlayerChoosing);
 		return;
 	}
 
@@ -95,6 +126,9 @@ void
 GameManager::OnNotify(TimerResultPtr result)
 {
 	// Someone's timer finished. Create everything and hand it off to the player
+	if (mRecorder)
+		mRecorder->OnNotify(result);
+
 	for (int i = 0; i < result->mQuantity; ++i)
 	{
 		GameObjectPtr resultObject = nullptr;
@@ -110,7 +144,8 @@ GameManager::OnNotify(TimerResultPtr result)
 			mPlayerController->AddGameObjectToPlayer(resultObject, result->mPlayerID);
 	}
 
-	//$TODO also let the renderer know stuff changed
+	if (mRenderComponent)
+		mRenderComponent->RequestRedraw();
 }
 
 GameObjectPtr
@@ -139,36 +174,109 @@ GameManager::GetNextObjectID()
 void
 GameManager::SelectTileFromMouse(int playerID)
 {
-	const auto pickedTile = mRenderComponent->DoPick();
+	if (!mRenderComponent)
+		return;
 
-	mBoardController->SetSelectedTileForPlayer(playerID, pickedTile);
-	mRenderComponent->SetSelection(mBoardController->GetSelectionCoordsForPlayer(playerID));
+	const auto tileID = mRenderComponent->DoPick();
+	if (mRecorder)
+	{
+		SelectTileCommand selectCmd(tileID);
+		mRecorder->OnNotify(&selectCmd);
+	}
+	SelectTile(playerID, tileID);
+}
+
+void
+GameManager::SelectTile(int playerID, int tileID)
+{
+	mBoardController->SetSelectedTileForPlayer(playerID, tileID);
+	ShowSelection(playerID);
 }
 
 void 
 GameManager::MoveTileSelection(int playerID, const AxialCoord& offset)
 {
 	mBoardController->MoveSelectionCoordsForPlayer(playerID, offset);
-	mRenderComponent->SetSelection(mBoardController->GetSelectionCoordsForPlayer(playerID));
+	ShowSelection(playerID);
+}
+
+void
+GameManager::ShowSelection(int playerID)
+{
+	if (mRenderComponent)
+		mRenderComponent->SetSelection(mBoardController->GetSelectionCoordsForPlayer(playerID));
 }
 
 void
 GameManager::GameLoop()
 {
+	//nothing happens between input and timers finishing, so the loop sleeps
+	// until one of them is due instead of redrawing as fast as it can
 	while (mRunGameLoop)
 	{
-		mRenderComponent->RenderScene();
-		mPlayerController->Tick();
+		Update();
+		mRenderComponent->RunFrame(mPlayerController->GetNextTimerDeadline());
 	}
 }
 
+void
+GameManager::Update()
+{
+	mPlayerController->Tick();
+}
+
 void
 GameManager::StartGame()
 {
+	//a headless game has nothing to wait on, it's driven with Update instead
+	assert(mRenderComponent);
 	mRunGameLoop = true;
 	GameLoop();
 }
 
+void
+GameManager::SetRecorder(ObserverPtr recorder)
+{
+	mRecorder = recorder;
+}
+
+void
+GameManager::SaveSnapshot(GameSnapshot& snapshot) const
+{
+	SnapshotWriter writer(snapshot);
+	SaveState(writer);
+}
+
+void
+GameManager::RestoreSnapshot(const GameSnapshot& snapshot)
+{
+	SnapshotReader reader(snapshot);
+	LoadState(reader);
+	assert(reader.IsAtEnd());
+}
+
+void
+GameManager::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mNextObjectID);
+	writer.Write(mCurPlayerChoosing);
+	mBoardController->SaveState(writer);
+	mPlayerController->SaveState(writer);
+}
+
+void
+GameManager::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mNextObjectID);
+	reader.Read(mCurPlayerChoosing);
+	mBoardController->LoadState(reader);
+	mPlayerController->LoadState(reader);
+
+	ShowSelection(mCurPlayerChoosing);
+	if (mRenderComponent)
+		mRenderComponent->RequestRedraw();
+}
+
 void
 GameManager::StopGame()
 {
@@ -9,6 +9,9 @@ class BoardRenderer;
 class BoardController;
 class GameObject;
 class PlayerController;
+class GameSnapshot;
+class SnapshotReader;
+class SnapshotWriter;
 
 struct TimerResult;
 
@@ -23,6 +26,8 @@ public:
 	GameManager(const GameManager&) = delete;
 	GameManager& operator=(const GameManager& rhs) = delete;
 
+	//renderComponent can be null for a headless game, commands that need
+	// the screen (picking, camera moves) are then ignored
 	GameManager(BoardRendererPtr renderComponent, BoardControllerPtr boardController, PlayerControllerPtr playerController);
 	~GameManager();
 
@@ -32,12 +37,29 @@ public:
 	void StartGame();
 	void StopGame();
 
+	//every command acted on and timer result handed out is passed on to the
+	// recorder too, picks as the SelectTileCommand they resolved to
+	void SetRecorder(ObserverPtr recorder);
+
+	//the whole game, for looking ahead or previewing a move and then putting it back.
+	//The renderer and recorder aren't part of it
+	void SaveSnapshot(GameSnapshot& snapshot) const;
+	void RestoreSnapshot(const GameSnapshot& snapshot);
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
+	//finishes any timers that are due. The game loop calls it each pass, a
+	// headless game calls it after moving its clock on
+	void Update();
+
 private:
 	void GameLoop();
 	
 	GameObjectPtr CreateResourceGameObject(const TimerResult& result);
 	void MoveTileSelection(int playerID, const AxialCoord& offset);
 	void SelectTileFromMouse(int playerID);
+	void SelectTile(int playerID, int tileID);
+	void ShowSelection(int playerID);
 
 	int GetNextObjectID();
 	
@@ -45,6 +67,7 @@ private:
 	BoardControllerPtr mBoardController;
 	BoardRendererPtr mRenderComponent;
 	PlayerControllerPtr mPlayerController;
+	ObserverPtr mRecorder;
 
 	int mNextObjectID;
 
@@ -0,0 +1,220 @@
+#include "GameSimulation.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Board.h"
+#include "BoardController.h"
+#include "BoardRenderer.h"
+#include "Commands.h"
+#include "GameObject.h"
+#include "GameSnapshot.h"
+#include "GameManager.h"
+#include "Player.h"
+#include "PlayerController.h"
+#include "ReplayLog.h"
+#include "Timer.h"
+
+namespace
+{
+	//random streams off the settings' seed, the board uses the seed itself
+	const std::uint64_t DEAL_STREAM = 1;
+	const std::uint64_t HARVEST_STREAM = 2;
+}
+
+GameSimulation::GameSimulation(const SimulationSettings& settings)
+	: mSettings(settings)
+	, mClock(std::make_shared<VirtualGameClock>())
+	, mBoardController(nullptr)
+	, mHarvestChoices(settings.mSeed, HARVEST_STREAM)
+{
+	assert(settings.mNumPlayers > 0 && settings.mTilesPerPlayer >= 0);
+
+	auto board = std::make_unique<Board>();
+	board->MakeBoard(settings.mNumTilesPerType, settings.mSeed);
+	if (settings.mHarvestRateBonus != 0)
+	{
+		for (int tileID = 0; tileID < board->GetNumTiles(); ++tileID)
+		{
+			const int rate = board->GetHarvestRate(tileID);
+			if (rate > 0)
+				board->SetHarvestRate(tileID, std::max(0, rate + settings.mHarvestRateBonus));
+		}
+	}
+	auto boardController = std::make_unique<BoardController>(std::move(board));
+	mBoardController = boardController.get();
+
+	PlayerList players;
+	for (int playerID = 0; playerID < settings.mNumPlayers; ++playerID)
+	{
+		auto timer = std::make_unique<TimerObject>(playerID);
+		players.push_back(std::make_unique<Player>(playerID, std::move(timer), settings.mNumStartingBills));
+	}
+	mPlayerController = std::make_shared<PlayerController>(players, *boardController, mClock);
+
+	mGameManager = std::make_shared<GameManager>(nullptr, std::move(boardController), mPlayerController);
+	mPlayerController->ObserveTimers(mGameManager);
+
+	DealTiles();
+}
+
+GameSimulation::~GameSimulation()
+{
+}
+
+void
+GameSimulation::DealTiles()
+{
+	//a shuffled board, dealt out round the table
+	const int numTiles = mBoardController->GetNumTiles();
+	assert(mSettings.mNumPlayers * mSettings.mTilesPerPlayer <= numTiles);
+
+	std::vector<int> tileIDs(numTiles);
+	for (int tileID = 0; tileID < numTiles; ++tileID)
+		tileIDs[tileID] = tileID;
+
+	CounterRandom rng(mSettings.mSeed, DEAL_STREAM);
+	for (int i = numTiles - 1; i > 0; --i)
+		std::swap(tileIDs[i], tileIDs[static_cast<int>(rng.NextBelow(i + 1))]);
+
+	mPlayerTiles.assign(mSettings.mNumPlayers, std::vector<int>());
+	for (int i = 0; i < mSettings.mNumPlayers * mSettings.mTilesPerPlayer; ++i)
+	{
+		const int playerID = i % mSettings.mNumPlayers;
+		mPlayerTiles[playerID].push_back(tileIDs[i]);
+		mPlayerController->AddTileToPlayer(tileIDs[i], playerID);
+	}
+}
+
+void
+GameSimulation::SendCommand(Command& command)
+{
+	mGameManager->OnNotify(&command);
+}
+
+bool
+GameSimulation::RunToNextTimer(GameClock::Clock::time_point endTime)
+{
+	const auto nextDeadline = mPlayerController->GetNextTimerDeadline();
+	if (nextDeadline > endTime)
+		return false;
+
+	AdvanceTo(nextDeadline);
+	return true;
+}
+
+void
+GameSimulation::AdvanceTo(GameClock::Clock::time_point time)
+{
+	mClock->AdvanceTo(time);
+	mGameManager->Update();
+}
+
+void
+GameSimulation::StartHarvest(int playerID)
+{
+	const auto& tiles = mPlayerTiles[playerID];
+	const auto tileID = tiles[static_cast<size_t>(mHarvestChoices.NextBelow(tiles.size()))];
+
+	ChangePlayerCommand changePlayer(playerID);
+	SelectTileCommand selectTile(tileID);
+	HarvestCommand harvest;
+	SendCommand(changePlayer);
+	SendCommand(selectTile);
+	SendCommand(harvest);
+}
+
+SimulationResult
+GameSimulation::PlayGame()
+{
+	SimulationResult result;
+	const auto endTime = mClock->Now() + mSettings.mGameLength;
+
+	while (mClock->Now() < endTime)
+	{
+		for (int playerID = 0; playerID < mSettings.mNumPlayers; ++playerID)
+		{
+			if (mPlayerController->IsPlayerTimerBusy(playerID))
+				continue;
+
+			StartHarvest(playerID);
+			result.mNumHarvests++;
+		}
+
+		if (!RunToNextTimer(endTime))
+			break;
+	}
+
+	for (int playerID = 0; playerID < mSettings.mNumPlayers; ++playerID)
+		result.mResourcesPerPlayer.push_back(GetNumResources(playerID));
+
+	return result;
+}
+
+void
+GameSimulation::SaveSnapshot(GameSnapshot& snapshot) const
+{
+	SnapshotWriter writer(snapshot);
+	mGameManager->SaveState(writer);
+	writer.Write(mClock->Now().time_since_epoch().count());
+	writer.Write(mHarvestChoices);
+}
+
+void
+GameSimulation::RestoreSnapshot(const GameSnapshot& snapshot)
+{
+	SnapshotReader reader(snapshot);
+	mGameManager->LoadState(reader);
+
+	GameClock::Clock::rep now;
+	reader.Read(now);
+	mClock->SetNow(GameClock::Clock::time_point(GameClock::Clock::duration(now)));
+	reader.Read(mHarvestChoices);
+	assert(reader.IsAtEnd());
+}
+
+void
+GameSimulation::StartRecording(ReplayWriter& writer)
+{
+	ReplayHeader header;
+	header.mSeed = mSettings.mSeed;
+	header.mNumTilesPerType = mSettings.mNumTilesPerType;
+	header.mNumPlayers = mSettings.mNumPlayers;
+	header.mNumStartingBills = mSettings.mNumStartingBills;
+	header.mHarvestRateBonus = mSettings.mHarvestRateBonus;
+	mRecorder = std::make_shared<ReplayRecorder>(writer, mClock, header);
+
+	for (int playerID = 0; playerID < mSettings.mNumPlayers; ++playerID)
+	{
+		for (auto tileID : mPlayerTiles[playerID])
+			mRecorder->RecordTileAssigned(tileID, playerID);
+	}
+
+	mGameManager->SetRecorder(mRecorder);
+}
+
+VirtualGameClock&
+GameSimulation::GetClock()
+{
+	return *mClock;
+}
+
+PlayerController&
+GameSimulation::GetPlayerController()
+{
+	return *mPlayerController;
+}
+
+const BoardController&
+GameSimulation::GetBoardController() const
+{
+	return *mBoardController;
+}
+
+int
+GameSimulation::GetNumResources(int playerID) const
+{
+	const auto objects = mPlayerController->GetGameObjectsFromTiles(playerID, mPlayerController->GetPlayerTiles(playerID));
+	return static_cast<int>(std::count_if(objects.begin(), objects.end(),
+		[](const GameObjectPtr& object) { return object->GetObjectType() == GameObjectType::RESOURCE; }));
+}
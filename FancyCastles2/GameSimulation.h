@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GameClock.h"
+#include "Random.h"
+
+class BoardController;
+class Command;
+class GameManager;
+class GameSnapshot;
+class PlayerController;
+class ReplayRecorder;
+class ReplayWriter;
+
+struct SimulationSettings
+{
+	int mNumPlayers;
+	int mNumTilesPerType;
+	int mTilesPerPlayer;	//0 to leave dealing to the caller
+	int mNumStartingBills;
+	int mHarvestRateBonus;	//added to every tile that harvests anything
+	std::chrono::steady_clock::duration mGameLength;
+	std::uint64_t mSeed;
+
+	SimulationSettings()
+		: mNumPlayers(6), mNumTilesPerType(20), mTilesPerPlayer(10)
+		, mNumStartingBills(5), mHarvestRateBonus(0)
+		, mGameLength(std::chrono::minutes(10)), mSeed(1) { }
+};
+
+struct SimulationResult
+{
+	int mNumHarvests;
+	std::vector<int> mResourcesPerPlayer;	//by player ID
+
+	SimulationResult() : mNumHarvests(0) { }
+};
+
+//A whole game with no window, renderer or waiting. The GameManager runs on a
+// VirtualGameClock and commands are sent to it directly, when nothing is left
+// to do until a timer finishes the clock jumps straight to that deadline.
+//The board, who gets which tiles and every choice PlayGame makes come from the
+// seed, so the same settings always play the same game
+class GameSimulation
+{
+public:
+	GameSimulation(const GameSimulation&) = delete;
+	GameSimulation& operator=(const GameSimulation& rhs) = delete;
+
+	explicit GameSimulation(const SimulationSettings& settings);
+	~GameSimulation();
+
+	//same as the command coming from the keyboard
+	void SendCommand(Command& command);
+
+	//moves the clock to the next timer deadline and finishes the timers due
+	// then. False, with the clock left alone, if there's none by endTime
+	bool RunToNextTimer(GameClock::Clock::time_point endTime);
+
+	//moves the clock to time and finishes the timers due by then
+	void AdvanceTo(GameClock::Clock::time_point time);
+
+	//every player starts a harvest on one of its tiles whenever its timer is
+	// free, until the game length is up
+	SimulationResult PlayGame();
+
+	//the game, the clock and the random choices PlayGame makes, so a restored
+	// game plays on exactly as it did after the snapshot was taken
+	void SaveSnapshot(GameSnapshot& snapshot) const;
+	void RestoreSnapshot(const GameSnapshot& snapshot);
+
+	//records the game from here on into writer, starting with the tiles dealt
+	void StartRecording(ReplayWriter& writer);
+
+	VirtualGameClock& GetClock();
+	PlayerController& GetPlayerController();
+	const BoardController& GetBoardController() const;
+	int GetNumResources(int playerID) const;
+
+private:
+	void DealTiles();
+	void StartHarvest(int playerID);
+
+	SimulationSettings mSettings;
+	std::shared_ptr<VirtualGameClock> mClock;
+	const BoardController* mBoardController;	//owned by mGameManager
+	std::shared_ptr<PlayerController> mPlayerController;
+	std::shared_ptr<GameManager> mGameManager;
+
+	//each player's tiles in the order they were dealt
+	std::vector<std::vector<int>> mPlayerTiles;
+	CounterRandom mHarvestChoices;
+	std::shared_ptr<ReplayRecorder> mRecorder;
+};
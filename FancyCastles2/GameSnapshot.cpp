@@ -0,0 +1,87 @@
+#include "GameSnapshot.h"
+
+#include <algorithm>
+
+const int GameSnapshot::PAGE_SIZE;
+
+size_t
+GameSnapshot::GetNumBytes() const
+{
+	return mBytes.size() + mPages.size() * PAGE_SIZE;
+}
+
+int
+GameSnapshot::GetNumPages() const
+{
+	return static_cast<int>(mPages.size());
+}
+
+int
+GameSnapshot::CountSharedPages(const GameSnapshot& other) const
+{
+	int numShared = 0;
+	for (size_t page = 0; page < std::min(mPages.size(), other.mPages.size()); ++page)
+		numShared += mPages[page] == other.mPages[page] ? 1 : 0;
+	return numShared;
+}
+
+SnapshotWriter::SnapshotWriter(GameSnapshot& snapshot)
+	: mSnapshot(snapshot)
+	, mNextPage(0)
+{
+	mSnapshot.mBytes.clear();
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+	mSnapshot.mPages.resize(mNextPage);
+}
+
+void
+SnapshotWriter::WritePages(const void* data, size_t numBytes)
+{
+	auto bytes = static_cast<const std::uint8_t*>(data);
+	for (size_t offset = 0; offset < numBytes; offset += GameSnapshot::PAGE_SIZE, ++mNextPage)
+	{
+		const auto pageBytes = std::min<size_t>(GameSnapshot::PAGE_SIZE, numBytes - offset);
+		if (mNextPage == mSnapshot.mPages.size())
+			mSnapshot.mPages.emplace_back();
+
+		//unchanged pages stay shared with any copies of the snapshot, changed ones
+		// are copied over in place unless a copy is still using them
+		auto& page = mSnapshot.mPages[mNextPage];
+		if (page && page->size() == pageBytes && std::memcmp(page->data(), bytes + offset, pageBytes) == 0)
+			continue;
+
+		if (!page || page.use_count() > 1)
+			page = std::make_shared<GameSnapshot::Page>(pageBytes);
+		page->resize(pageBytes);
+		std::memcpy(page->data(), bytes + offset, pageBytes);
+	}
+}
+
+SnapshotReader::SnapshotReader(const GameSnapshot& snapshot)
+	: mSnapshot(snapshot)
+	, mOffset(0)
+	, mNextPage(0)
+{
+}
+
+void
+SnapshotReader::ReadPages(void* data, size_t numBytes)
+{
+	auto bytes = static_cast<std::uint8_t*>(data);
+	for (size_t offset = 0; offset < numBytes; offset += GameSnapshot::PAGE_SIZE, ++mNextPage)
+	{
+		assert(mNextPage < mSnapshot.mPages.size());
+		const auto& page = *mSnapshot.mPages[mNextPage];
+		assert(page.size() == std::min<size_t>(GameSnapshot::PAGE_SIZE, numBytes - offset));
+		std::memcpy(bytes + offset, page.data(), page.size());
+	}
+}
+
+bool
+SnapshotReader::IsAtEnd() const
+{
+	return mOffset == mSnapshot.mBytes.size() && mNextPage == mSnapshot.mPages.size();
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//A copy of everything a game needs to carry on from where it was taken.
+//Each part of the game writes its state into one flat byte buffer with plain
+// memcpys, and reads it back in the same order, so saving and restoring is a
+// run of bulk copies with no pointers to chase.
+//Big tile columns go into fixed size pages instead. Copying a snapshot shares
+// its pages, and saving into a snapshot again only copies the pages that changed,
+// so many snapshots of one big board cost little more than one
+class GameSnapshot
+{
+public:
+	static const int PAGE_SIZE = 4096;
+
+	size_t GetNumBytes() const;
+	int GetNumPages() const;
+
+	//pages this snapshot has in common with other, without copying
+	int CountSharedPages(const GameSnapshot& other) const;
+
+private:
+	friend class SnapshotWriter;
+	friend class SnapshotReader;
+
+	using Page = std::vector < std::uint8_t > ;
+	using PagePtr = std::shared_ptr < Page > ;
+
+	std::vector<std::uint8_t> mBytes;
+	std::vector<PagePtr> mPages;
+};
+
+//Fills a snapshot. The buffer keeps its capacity, so saving into the same
+// snapshot again doesn't allocate
+class SnapshotWriter
+{
+public:
+	SnapshotWriter(const SnapshotWriter&) = delete;
+	SnapshotWriter& operator=(const SnapshotWriter& rhs) = delete;
+
+	explicit SnapshotWriter(GameSnapshot& snapshot);
+	//drops pages left over from a bigger game
+	~SnapshotWriter();
+
+	template <typename T>
+	void Write(const T& value)
+	{
+		WriteArray(&value, 1);
+	}
+
+	template <typename T>
+	void WriteArray(const T* values, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "snapshots are memcpy'd");
+		const auto numBytes = sizeof(T) * count;
+		const auto offset = mSnapshot.mBytes.size();
+		mSnapshot.mBytes.resize(offset + numBytes);
+		if (numBytes > 0)
+			std::memcpy(mSnapshot.mBytes.data() + offset, values, numBytes);
+	}
+
+	//size first, so it can be read back into an empty vector
+	template <typename T>
+	void WriteVector(const std::vector<T>& values)
+	{
+		Write(static_cast<std::uint64_t>(values.size()));
+		WriteArray(values.data(), values.size());
+	}
+
+	//into pages, a page already holding the same bytes is kept as it is
+	void WritePages(const void* data, size_t numBytes);
+
+private:
+	GameSnapshot& mSnapshot;
+	size_t mNextPage;
+};
+
+//Reads a snapshot back in the order it was written
+class SnapshotReader
+{
+public:
+	SnapshotReader(const SnapshotReader&) = delete;
+	SnapshotReader& operator=(const SnapshotReader& rhs) = delete;
+
+	explicit SnapshotReader(const GameSnapshot& snapshot);
+
+	template <typename T>
+	void Read(T& value)
+	{
+		ReadArray(&value, 1);
+	}
+
+	template <typename T>
+	void ReadArray(T* values, size_t count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "snapshots are memcpy'd");
+		const auto numBytes = sizeof(T) * count;
+		assert(mOffset + numBytes <= mSnapshot.mBytes.size());
+		if (numBytes > 0)
+			std::memcpy(values, mSnapshot.mBytes.data() + mOffset, numBytes);
+		mOffset += numBytes;
+	}
+
+	template <typename T>
+	void ReadVector(std::vector<T>& values)
+	{
+		std::uint64_t size;
+		Read(size);
+		values.resize(static_cast<size_t>(size));
+		ReadArray(values.data(), values.size());
+	}
+
+	//steps over a vector without reading it anywhere
+	template <typename T>
+	void SkipVector()
+	{
+		std::uint64_t size;
+		Read(size);
+		assert(mOffset + sizeof(T) * size <= mSnapshot.mBytes.size());
+		mOffset += static_cast<size_t>(sizeof(T) * size);
+	}
+
+	void ReadPages(void* data, size_t numBytes);
+
+	//true once everything written has been read
+	bool IsAtEnd() const;
+
+private:
+	const GameSnapshot& mSnapshot;
+	size_t mOffset;
+	size_t mNextPage;
+};
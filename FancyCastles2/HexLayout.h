@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "HexMath.h"
+#include "TileTraits.h"
+
+//Where hexes land in the world. Tile centers are laid out in world units and
+// the shaders put a hex with a corner radius of HEX_SIZE around each one, the
+// Camera takes it from there to the screen.
+//The renderer hands the tile spacing to the shaders, HEX_SIZE has to match
+// geo.glsl and hexvert.glsl
+namespace HexLayout
+{
+	const float HEX_SIZE = 1.f;
+
+	//gives a little space between tiles
+	const float BORDER = 0.01f;
+	const float SQRT_3_OVER_2 = 0.8660254f;
+	const float HEX_HEIGHT = 2.f * HEX_SIZE + BORDER;
+	const float HEX_WIDTH = SQRT_3_OVER_2 * HEX_HEIGHT + BORDER;
+
+	//how much of the world the camera shows either side of its center at a zoom of 1
+	const float VIEW_HALF_WIDTH = 1366.f / 100.f;
+	const float VIEW_HALF_HEIGHT = 768.f / 100.f;
+
+	//axis aligned box in world units
+	struct WorldRect
+	{
+		float mMinX, mMinY;
+		float mMaxX, mMaxY;
+
+		WorldRect() : mMinX(0.f), mMinY(0.f), mMaxX(-1.f), mMaxY(-1.f) { }
+		WorldRect(float minX, float minY, float maxX, float maxY) : mMinX(minX), mMinY(minY), mMaxX(maxX), mMaxY(maxY) { }
+
+		bool IsEmpty() const { return mMinX > mMaxX || mMinY > mMaxY; }
+
+		bool Intersects(const WorldRect& other) const
+		{
+			return !IsEmpty() && !other.IsEmpty() &&
+				mMinX <= other.mMaxX && other.mMinX <= mMaxX &&
+				mMinY <= other.mMaxY && other.mMinY <= mMaxY;
+		}
+
+		//grow to cover the point
+		void Add(float x, float y)
+		{
+			if (IsEmpty())
+			{
+				*this = WorldRect(x, y, x, y);
+				return;
+			}
+			mMinX = std::min(mMinX, x);
+			mMinY = std::min(mMinY, y);
+			mMaxX = std::max(mMaxX, x);
+			mMaxY = std::max(mMaxY, y);
+		}
+	};
+
+	inline void
+	GetCartesianFromAxial(float& x, float& y, const AxialCoord& position)
+	{
+		x = HEX_WIDTH * position.r + HEX_WIDTH / 2.f * position.q;
+		y = -0.75f * HEX_HEIGHT * position.q;
+	}
+
+	//offset of a hex's corner from its center, corner 0 is 30 degrees up from +x
+	// and the rest follow counterclockwise, same as geo.glsl
+	inline void
+	GetHexCorner(float& x, float& y, int corner)
+	{
+		const float angle = 2.f * 3.14159265f / 6.f * (corner + 0.5f);
+		x = HEX_SIZE * std::cos(angle);
+		y = HEX_SIZE * std::sin(angle);
+	}
+
+	//inverse of GetCartesianFromAxial, rounded to the nearest tile center
+	inline AxialCoord
+	GetAxialFromCartesian(float x, float y)
+	{
+		const double q = -y / (0.75 * HEX_HEIGHT);
+		const double r = x / HEX_WIDTH - q / 2.0;
+		return HexMath::AxialRound(r, q);
+	}
+
+	//true if the point is inside the hex drawn for the tile, not in the border around it.
+	//The hexes are pointy topped so the flat sides face +-x, +-60 and +-120 degrees
+	inline bool
+	IsInsideHex(float x, float y, const AxialCoord& position)
+	{
+		float centerX, centerY;
+		GetCartesianFromAxial(centerX, centerY, position);
+		const float dx = x - centerX;
+		const float dy = y - centerY;
+		const float inradius = SQRT_3_OVER_2 * HEX_SIZE;
+
+		return std::abs(dx) <= inradius &&
+			std::abs(0.5f * dx + SQRT_3_OVER_2 * dy) <= inradius &&
+			std::abs(-0.5f * dx + SQRT_3_OVER_2 * dy) <= inradius;
+	}
+
+	//find the hex drawn under a world position. The spacing isn't quite a regular
+	// hex grid, so if rounding misses the drawn hex its neighbors get a look too
+	inline bool
+	PickHex(float x, float y, AxialCoord& picked)
+	{
+		const auto rounded = GetAxialFromCartesian(x, y);
+		if (IsInsideHex(x, y, rounded))
+		{
+			picked = rounded;
+			return true;
+		}
+
+		for (const auto& direction : HexMath::DIRECTIONS)
+		{
+			if (IsInsideHex(x, y, rounded + direction))
+			{
+				picked = rounded + direction;
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
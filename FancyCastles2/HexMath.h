@@ -0,0 +1,219 @@
+#pragma once
+
+#include "TileTraits.h"
+
+//Hex grid geometry on axial coordinates. Everything here is constexpr so
+// fixed offsets, distances and shapes fold away at compile time.
+//Cube coordinates are x = q, z = r, y = -q - r
+namespace HexMath
+{
+	struct CubeCoord
+	{
+		int x, y, z;
+		constexpr CubeCoord() : x(0), y(0), z(0) { }
+		constexpr CubeCoord(int x_in, int y_in, int z_in) : x(x_in), y(y_in), z(z_in) { }
+
+		constexpr bool operator==(const CubeCoord& other) const
+		{
+			return other.x == x && other.y == y && other.z == z;
+		}
+	};
+
+	//the six neighbor offsets, in order around the hex
+	constexpr AxialCoord DIRECTIONS[6] =
+	{
+		{ 0, 1 }, { -1, 1 }, { -1, 0 },
+		{ 0, -1 }, { 1, -1 }, { 1, 0 }
+	};
+
+	constexpr int NUM_DIRECTIONS = 6;
+
+	constexpr int
+	Abs(int value)
+	{
+		return value < 0 ? -value : value;
+	}
+
+	constexpr int
+	Max(int a, int b)
+	{
+		return a < b ? b : a;
+	}
+
+	constexpr CubeCoord
+	ToCube(const AxialCoord& coord)
+	{
+		return CubeCoord(coord.q, -coord.q - coord.r, coord.r);
+	}
+
+	constexpr AxialCoord
+	ToAxial(const CubeCoord& cube)
+	{
+		return AxialCoord(cube.z, cube.x);
+	}
+
+	//number of steps from the origin
+	constexpr int
+	Length(const AxialCoord& coord)
+	{
+		return (Abs(coord.r) + Abs(coord.q) + Abs(coord.r + coord.q)) / 2;
+	}
+
+	constexpr int
+	Distance(const AxialCoord& a, const AxialCoord& b)
+	{
+		return Length(a - b);
+	}
+
+	constexpr AxialCoord
+	Direction(int direction)
+	{
+		return DIRECTIONS[((direction % NUM_DIRECTIONS) + NUM_DIRECTIONS) % NUM_DIRECTIONS];
+	}
+
+	constexpr AxialCoord
+	Neighbor(const AxialCoord& coord, int direction)
+	{
+		return coord + Direction(direction);
+	}
+
+	//60 degree turns about the origin. RotateRight takes DIRECTIONS[i] to
+	// DIRECTIONS[i + 1], RotateLeft goes the other way
+	constexpr AxialCoord
+	RotateLeft(const AxialCoord& coord)
+	{
+		return ToAxial(CubeCoord(-ToCube(coord).z, -ToCube(coord).x, -ToCube(coord).y));
+	}
+
+	constexpr AxialCoord
+	RotateRight(const AxialCoord& coord)
+	{
+		return ToAxial(CubeCoord(-ToCube(coord).y, -ToCube(coord).z, -ToCube(coord).x));
+	}
+
+	constexpr AxialCoord
+	Rotate(const AxialCoord& coord, int turnsLeft)
+	{
+		return turnsLeft > 0 ? Rotate(RotateLeft(coord), turnsLeft - 1)
+			: turnsLeft < 0 ? Rotate(RotateRight(coord), turnsLeft + 1)
+			: coord;
+	}
+
+	constexpr AxialCoord
+	RotateAround(const AxialCoord& coord, const AxialCoord& center, int turnsLeft)
+	{
+		return center + Rotate(coord - center, turnsLeft);
+	}
+
+	//mirror across the axis where that cube coordinate is held fixed
+	constexpr AxialCoord
+	ReflectQ(const AxialCoord& coord)
+	{
+		return ToAxial(CubeCoord(ToCube(coord).x, ToCube(coord).z, ToCube(coord).y));
+	}
+
+	constexpr AxialCoord
+	ReflectR(const AxialCoord& coord)
+	{
+		return ToAxial(CubeCoord(ToCube(coord).y, ToCube(coord).x, ToCube(coord).z));
+	}
+
+	constexpr AxialCoord
+	ReflectS(const AxialCoord& coord)
+	{
+		return ToAxial(CubeCoord(ToCube(coord).z, ToCube(coord).y, ToCube(coord).x));
+	}
+
+	//number of hexes exactly radius steps away
+	constexpr int
+	RingSize(int radius)
+	{
+		return radius == 0 ? 1 : 6 * radius;
+	}
+
+	//number of hexes at most radius steps away
+	constexpr int
+	HexCount(int radius)
+	{
+		return 3 * radius * (radius + 1) + 1;
+	}
+
+	//index-th hex of a ring, walking around from the corner in direction 4
+	constexpr AxialCoord
+	RingCoord(const AxialCoord& center, int radius, int index)
+	{
+		return radius == 0 ? center
+			: center + Direction(4 + index / radius) * radius + Direction(index / radius) * (index % radius);
+	}
+
+	//ring that the index-th hex of a spiral outward from the center lands on
+	constexpr int
+	SpiralRing(int index, int ring = 0)
+	{
+		return HexCount(ring) > index ? ring : SpiralRing(index, ring + 1);
+	}
+
+	//spiral order is the center, then each ring in turn in RingCoord order
+	constexpr AxialCoord
+	SpiralCoord(const AxialCoord& center, int index)
+	{
+		return index == 0 ? center
+			: RingCoord(center, SpiralRing(index), index - HexCount(SpiralRing(index) - 1));
+	}
+
+	//round fractional cube coords to the hex containing them
+	constexpr int
+	RoundToInt(double value)
+	{
+		return value >= 0.0 ? static_cast<int>(value + 0.5) : -static_cast<int>(-value + 0.5);
+	}
+
+	constexpr double
+	AbsDiff(double a, double b)
+	{
+		return a < b ? b - a : a - b;
+	}
+
+	constexpr AxialCoord
+	CubeRound(double x, double y, double z)
+	{
+		//the coordinate that moved the most gets recomputed from the other two
+		return (AbsDiff(RoundToInt(x), x) > AbsDiff(RoundToInt(y), y) && AbsDiff(RoundToInt(x), x) > AbsDiff(RoundToInt(z), z))
+			? ToAxial(CubeCoord(-RoundToInt(y) - RoundToInt(z), RoundToInt(y), RoundToInt(z)))
+			: (AbsDiff(RoundToInt(y), y) > AbsDiff(RoundToInt(z), z))
+			? ToAxial(CubeCoord(RoundToInt(x), -RoundToInt(x) - RoundToInt(z), RoundToInt(z)))
+			: ToAxial(CubeCoord(RoundToInt(x), RoundToInt(y), -RoundToInt(x) - RoundToInt(y)));
+	}
+
+	constexpr AxialCoord
+	AxialRound(double r, double q)
+	{
+		return CubeRound(q, -q - r, r);
+	}
+
+	//number of hexes on the line from a to b, both ends included
+	constexpr int
+	LineSize(const AxialCoord& a, const AxialCoord& b)
+	{
+		return Distance(a, b) + 1;
+	}
+
+	//index-th hex on the line from a to b. The endpoints are nudged by a tiny
+	// amount so points landing exactly on an edge always pick the same side
+	constexpr AxialCoord
+	LineCoord(const AxialCoord& a, const AxialCoord& b, int index)
+	{
+		return Distance(a, b) == 0 ? a
+			: CubeRound(
+				ToCube(a).x + 1e-6 + (ToCube(b).x - ToCube(a).x) * (static_cast<double>(index) / Distance(a, b)),
+				ToCube(a).y + 2e-6 + (ToCube(b).y - ToCube(a).y) * (static_cast<double>(index) / Distance(a, b)),
+				ToCube(a).z - 3e-6 + (ToCube(b).z - ToCube(a).z) * (static_cast<double>(index) / Distance(a, b)));
+	}
+
+	//true if the coord is inside a hexagon shaped board of the given radius centered on the origin
+	constexpr bool
+	IsInsideRadius(const AxialCoord& coord, int radius)
+	{
+		return Length(coord) <= radius;
+	}
+}
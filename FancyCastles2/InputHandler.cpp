@@ -27,10 +27,17 @@ static void MouseButtonCallback(GLFWwindow* window, int button, int action, int
 	}
 }
 
+static void ScrollCallback(GLFWwindow* window, double xOffset, double yOffset)
+{
+	auto inputHandler = reinterpret_cast<InputHandler*>(glfwGetWindowUserPointer(window));
+	inputHandler->HandleScroll(yOffset);
+}
+
 InputHandler::InputHandler(GLFWwindow* window)
 {
 	glfwSetKeyCallback(window, KeyboardCallback);
 	glfwSetMouseButtonCallback(window, MouseButtonCallback);
+	glfwSetScrollCallback(window, ScrollCallback);
 
 	mKeyboardInputMap[GLFW_KEY_LEFT] = std::make_unique<MoveSelectionCommand>(0, -1);
 	mKeyboardInputMap[GLFW_KEY_RIGHT] = std::make_unique<MoveSelectionCommand>(0, 1);
@@ -40,6 +47,18 @@ InputHandler::InputHandler(GLFWwindow* window)
 	mKeyboardInputMap[GLFW_KEY_B] = std::make_unique<BuildCommand>();
 	mKeyboardInputMap[GLFW_KEY_ESCAPE] = std::make_unique<ExitGameCommand>();
 
+	//camera
+	const float panPixels = 100.f;
+	const float zoomFactor = 1.25f;
+	mKeyboardInputMap[GLFW_KEY_A] = std::make_unique<PanCameraCommand>(-panPixels, 0.f);
+	mKeyboardInputMap[GLFW_KEY_D] = std::make_unique<PanCameraCommand>(panPixels, 0.f);
+	mKeyboardInputMap[GLFW_KEY_W] = std::make_unique<PanCameraCommand>(0.f, panPixels);
+	mKeyboardInputMap[GLFW_KEY_S] = std::make_unique<PanCameraCommand>(0.f, -panPixels);
+	mKeyboardInputMap[GLFW_KEY_EQUAL] = std::make_unique<ZoomCameraCommand>(zoomFactor);
+	mKeyboardInputMap[GLFW_KEY_MINUS] = std::make_unique<ZoomCameraCommand>(1.f / zoomFactor);
+	mScrollUpCommand = std::make_unique<ZoomCameraCommand>(zoomFactor);
+	mScrollDownCommand = std::make_unique<ZoomCameraCommand>(1.f / zoomFactor);
+
 	//TODO- there must be a better way
 	mKeyboardInputMap[GLFW_KEY_1] = std::make_unique<ChangePlayerCommand>(1);
 	mKeyboardInputMap[GLFW_KEY_2] = std::make_unique<ChangePlayerCommand>(2);
@@ -69,4 +88,13 @@ InputHandler::HandleMouseClick(int button)
 	const auto command = mMouseInputMap.find(button);
 	if (command != mMouseInputMap.end())
 		Notify(command->second.get());
+}
+
+void
+InputHandler::HandleScroll(double yOffset)
+{
+	if (yOffset > 0.0)
+		Notify(mScrollUpCommand.get());
+	else if (yOffset < 0.0)
+		Notify(mScrollDownCommand.get());
 }
\ No newline at end of file
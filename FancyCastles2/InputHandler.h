@@ -17,9 +17,12 @@ public:
 
 	void HandleMouseClick(int buton);
 	void HandleKeyPress(int key);
+	void HandleScroll(double yOffset);
 	
 private:
 	std::unordered_map<int, std::unique_ptr<Command> > mKeyboardInputMap;
 	std::unordered_map<int, std::unique_ptr<Command> > mMouseInputMap;
+	std::unique_ptr<Command> mScrollUpCommand;
+	std::unique_ptr<Command> mScrollDownCommand;
 
 };
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "MatchRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <thread>
+
+namespace
+{
+	//A worker's unplayed matches [begin, end), begin in the high half and end in the
+	// low half so the owner taking from the front and thieves taking from the back
+	// can both do it with one compare and swap. Matches only ever move out of a
+	// range, so a stale value can't come back and fool a compare and swap.
+	//Ranges are padded out to a cache line so workers don't fight over neighbors
+	struct WorkRange
+	{
+		std::atomic<std::uint64_t> mRange;
+		char mPadding[64 - sizeof(std::atomic<std::uint64_t>)];
+
+		static std::uint64_t Pack(std::uint32_t begin, std::uint32_t end) { return (static_cast<std::uint64_t>(begin) << 32) | end; }
+		static std::uint32_t Begin(std::uint64_t range) { return static_cast<std::uint32_t>(range >> 32); }
+		static std::uint32_t End(std::uint64_t range) { return static_cast<std::uint32_t>(range); }
+
+		//the owner's next match, false if it has none left
+		bool Pop(std::uint32_t& match)
+		{
+			auto range = mRange.load();
+			while (Begin(range) < End(range))
+			{
+				if (mRange.compare_exchange_weak(range, Pack(Begin(range) + 1, End(range))))
+				{
+					match = Begin(range);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//take the back half of the victim's matches, false if it has none left
+		bool StealFrom(WorkRange& victim)
+		{
+			auto range = victim.mRange.load();
+			while (Begin(range) < End(range))
+			{
+				const auto mid = End(range) - (End(range) - Begin(range) + 1) / 2;
+				if (victim.mRange.compare_exchange_weak(range, Pack(Begin(range), mid)))
+				{
+					//only the owner ever stores into its own range, and only once it's empty
+					mRange.store(Pack(mid, End(range)));
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	void
+	RunWorker(int workerIndex, WorkRange* ranges, int numWorkers, const MatchList& matches, MatchResultList& results)
+	{
+		auto& own = ranges[workerIndex];
+		for (;;)
+		{
+			std::uint32_t match;
+			while (own.Pop(match))
+			{
+				GameSimulation sim(matches[match]);
+				results[match] = sim.PlayGame();
+			}
+
+			//look round the other workers starting from the next one along, when none
+			// has anything left there's nothing more to do since matches are never added
+			bool stole = false;
+			for (int i = 1; i < numWorkers && !stole; ++i)
+				stole = own.StealFrom(ranges[(workerIndex + i) % numWorkers]);
+			if (!stole)
+				return;
+		}
+	}
+}
+
+MatchRunner::MatchRunner(int numThreads)
+	: mNumThreads(numThreads > 0 ? numThreads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())))
+{
+}
+
+int
+MatchRunner::GetNumThreads() const
+{
+	return mNumThreads;
+}
+
+MatchResultList
+MatchRunner::Run(const MatchList& matches) const
+{
+	const int numMatches = static_cast<int>(matches.size());
+	MatchResultList results(matches.size());
+	const int numWorkers = std::max(1, std::min(mNumThreads, numMatches));
+
+	std::unique_ptr<WorkRange[]> ranges(new WorkRange[numWorkers]);
+	for (int worker = 0; worker < numWorkers; ++worker)
+	{
+		const auto begin = static_cast<std::uint32_t>(static_cast<long long>(numMatches) * worker / numWorkers);
+		const auto end = static_cast<std::uint32_t>(static_cast<long long>(numMatches) * (worker + 1) / numWorkers);
+		ranges[worker].mRange.store(WorkRange::Pack(begin, end));
+	}
+
+	std::vector<std::thread> workers;
+	workers.reserve(numWorkers - 1);
+	for (int worker = 1; worker < numWorkers; ++worker)
+		workers.emplace_back(RunWorker, worker, ranges.get(), numWorkers, std::cref(matches), std::ref(results));
+
+	RunWorker(0, ranges.get(), numWorkers, matches, results);
+
+	for (auto& worker : workers)
+		worker.join();
+
+	return results;
+}
+
+MatchList
+MatchRunner::MakeSweep(const SimulationSettings& base, const MatchSweep& sweep)
+{
+	//an empty list keeps the base settings' value
+	const auto orBase = [](const std::vector<int>& values, int baseValue)
+	{
+		return values.empty() ? std::vector<int>(1, baseValue) : values;
+	};
+	const auto numPlayers = orBase(sweep.mNumPlayers, base.mNumPlayers);
+	const auto numTilesPerType = orBase(sweep.mNumTilesPerType, base.mNumTilesPerType);
+	const auto numStartingBills = orBase(sweep.mNumStartingBills, base.mNumStartingBills);
+	const auto harvestRateBonuses = orBase(sweep.mHarvestRateBonuses, base.mHarvestRateBonus);
+
+	MatchList matches;
+	matches.reserve(numPlayers.size() * numTilesPerType.size() * numStartingBills.size() * harvestRateBonuses.size() * sweep.mGamesPerSetting);
+	for (auto players : numPlayers)
+		for (auto tilesPerType : numTilesPerType)
+			for (auto bills : numStartingBills)
+				for (auto rateBonus : harvestRateBonuses)
+					for (int game = 0; game < sweep.mGamesPerSetting; ++game)
+					{
+						auto settings = base;
+						settings.mNumPlayers = players;
+						settings.mNumTilesPerType = tilesPerType;
+						settings.mNumStartingBills = bills;
+						settings.mHarvestRateBonus = rateBonus;
+						settings.mSeed = base.mSeed + game;
+						matches.push_back(settings);
+					}
+
+	return matches;
+}
+
+void
+MatchRunner::WriteCsv(std::ostream& out, const MatchList& matches, const MatchResultList& results)
+{
+	assert(matches.size() == results.size());
+
+	out << "match,seed,players,tiles_per_type,tiles_per_player,starting_bills,harvest_rate_bonus,game_seconds,"
+		"harvests,total_resources,min_resources,max_resources\n";
+
+	for (size_t match = 0; match < matches.size(); ++match)
+	{
+		const auto& settings = matches[match];
+		const auto& resources = results[match].mResourcesPerPlayer;
+		const auto total = std::accumulate(resources.begin(), resources.end(), 0);
+		const auto minMax = std::minmax_element(resources.begin(), resources.end());
+
+		out << match << ',' << settings.mSeed << ',' << settings.mNumPlayers << ',' << settings.mNumTilesPerType << ','
+			<< settings.mTilesPerPlayer << ',' << settings.mNumStartingBills << ',' << settings.mHarvestRateBonus << ','
+			<< std::chrono::duration_cast<std::chrono::seconds>(settings.mGameLength).count() << ','
+			<< results[match].mNumHarvests << ',' << total << ','
+			<< (resources.empty() ? 0 : *minMax.first) << ',' << (resources.empty() ? 0 : *minMax.second) << '\n';
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+
+#include "GameSimulation.h"
+
+using MatchList = std::vector < SimulationSettings > ;
+using MatchResultList = std::vector < SimulationResult > ;
+
+//the values a balance sweep tries, every combination gets mGamesPerSetting
+// games with seeds counting up from the base settings' seed
+struct MatchSweep
+{
+	std::vector<int> mNumPlayers;
+	std::vector<int> mNumTilesPerType;
+	std::vector<int> mNumStartingBills;
+	std::vector<int> mHarvestRateBonuses;
+	int mGamesPerSetting;
+
+	MatchSweep() : mGamesPerSetting(1) { }
+};
+
+//Plays a batch of independent GameSimulation matches on worker threads.
+//Each worker starts with an even share of the matches and when it runs out
+// steals half of what's left from another worker, so a few long games can't
+// leave the rest of the threads idle. Matches share nothing, every one builds
+// its own board, players and game manager and writes only its own result slot,
+// so results are the same whatever the thread count
+class MatchRunner
+{
+public:
+	//0 threads for one per hardware thread
+	explicit MatchRunner(int numThreads = 0);
+
+	//results come back in the same order as the matches
+	MatchResultList Run(const MatchList& matches) const;
+
+	int GetNumThreads() const;
+
+	static MatchList MakeSweep(const SimulationSettings& base, const MatchSweep& sweep);
+
+	//one row per match with its settings and result, in match order
+	static void WriteCsv(std::ostream& out, const MatchList& matches, const MatchResultList& results);
+
+private:
+	int mNumThreads;
+};
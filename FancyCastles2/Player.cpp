@@ -1,10 +1,37 @@
 #include "Player.h"
 
+#include <atomic>
+#include <cassert>
+#include <vector>
+
 #include "GameObject.h"
+#include "GameSnapshot.h"
 #include "Timer.h"
 
+namespace
+{
+	//what's needed to make a player's object again
+	struct ObjectRecord
+	{
+		int mObjectID;
+		int mPosition;
+		GameObjectType mType;
+		int mSubtype;	//ResourceType or BuildingType
+	};
+
+	//shared by every player in every game, so no two contents ever get the same version
+	std::atomic<std::uint64_t> sLastContentsVersion(0);
+
+	std::uint64_t
+	NextContentsVersion()
+	{
+		return ++sLastContentsVersion;
+	}
+}
+
 Player::Player(int playerID, TimerPtr timer, int numBills)
 	: mPlayerID(playerID), mTimer(std::move(timer)), mNumBills(numBills)
+	, mContentsVersion(NextContentsVersion())
 {
 }
 
@@ -36,12 +63,14 @@ void
 Player::AddTile(int tileID)
 {
 	mPlayerTileIDs.insert(tileID);
+	OnContentsChanged();
 }
 
 void
 Player::RemoveTile(int tileID)
 {
 	mPlayerTileIDs.erase(tileID);
+	OnContentsChanged();
 }
 
 bool
@@ -60,12 +89,14 @@ void
 Player::AddGameObject(GameObjectPtr obj)
 {
 	mPlayerObjects.insert(obj);
+	OnContentsChanged();
 }
 
 void
 Player::RemoveGameObject(GameObjectPtr obj)
 {
 	mPlayerObjects.erase(obj);
+	OnContentsChanged();
 }
 
 GameObjectSet
@@ -78,4 +109,76 @@ TimerObject&
 Player::GetTimer()
 {
 	return *mTimer;
-}
\ No newline at end of file
+}
+
+const TimerObject&
+Player::GetTimer() const
+{
+	return *mTimer;
+}
+
+void
+Player::OnContentsChanged()
+{
+	mContentsVersion = NextContentsVersion();
+}
+
+void
+Player::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mNumBills);
+	writer.Write(mContentsVersion);
+	writer.WriteVector(std::vector<int>(mPlayerTileIDs.begin(), mPlayerTileIDs.end()));
+
+	std::vector<ObjectRecord> objects;
+	objects.reserve(mPlayerObjects.size());
+	for (const auto& object : mPlayerObjects)
+	{
+		ObjectRecord record = { object->GetObjectID(), object->GetPosition(), object->GetObjectType(), 0 };
+		if (record.mType == GameObjectType::RESOURCE)
+			record.mSubtype = static_cast<int>(static_cast<const ResourceObject&>(*object).GetResourceType());
+		else if (record.mType == GameObjectType::BUILDING)
+			record.mSubtype = static_cast<int>(static_cast<const BuildingObject&>(*object).GetBuildingType());
+		objects.push_back(record);
+	}
+	writer.WriteVector(objects);
+
+	mTimer->SaveState(writer);
+}
+
+void
+Player::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mNumBills);
+
+	std::uint64_t contentsVersion;
+	reader.Read(contentsVersion);
+	if (contentsVersion == mContentsVersion)
+	{
+		reader.SkipVector<int>();
+		reader.SkipVector<ObjectRecord>();
+		mTimer->LoadState(reader);
+		return;
+	}
+	mContentsVersion = contentsVersion;
+
+	std::vector<int> tileIDs;
+	reader.ReadVector(tileIDs);
+	mPlayerTileIDs.clear();
+	mPlayerTileIDs.insert(tileIDs.begin(), tileIDs.end());
+
+	std::vector<ObjectRecord> objects;
+	reader.ReadVector(objects);
+	mPlayerObjects.clear();
+	for (const auto& record : objects)
+	{
+		if (record.mType == GameObjectType::RESOURCE)
+			mPlayerObjects.insert(std::make_shared<ResourceObject>(record.mObjectID, record.mPosition, static_cast<ResourceType>(record.mSubtype)));
+		else if (record.mType == GameObjectType::BUILDING)
+			mPlayerObjects.insert(std::make_shared<BuildingObject>(record.mObjectID, record.mPosition, static_cast<BuildingType>(record.mSubtype)));
+		else
+			assert(false);
+	}
+
+	mTimer->LoadState(reader);
+}
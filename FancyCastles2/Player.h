@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <unordered_set>
 
 class GameObject;
+class SnapshotReader;
+class SnapshotWriter;
 class TimerObject;
 enum class GameObjectType;
 
@@ -33,12 +36,25 @@ public:
 	GameObjectSet GetGameObjects() const;
 
 	TimerObject& GetTimer();
+	const TimerObject& GetTimer() const;
+
+	//objects are saved as plain records and only made again on restore if the
+	// player's tiles or objects have changed since the snapshot was taken
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
 
 private:
+	void OnContentsChanged();
+
 	int mPlayerID;
 	int mNumBills;
 
 	TileIDSet mPlayerTileIDs;
 	GameObjectSet mPlayerObjects;
 	TimerPtr mTimer;
+
+	//changes every time the tiles or objects do. Versions come from one counter
+	// for the whole process, so no other player or game ever has the same one and
+	// matching a snapshot's version means nothing needs rebuilding
+	std::uint64_t mContentsVersion;
 };
\ No newline at end of file
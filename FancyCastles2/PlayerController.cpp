@@ -1,16 +1,25 @@
 #include "PlayerController.h"
 
+#include <algorithm>
 #include <assert.h>
 
 #include "GameObject.h"
+#include "GameSnapshot.h"
+#include "TerritoryMap.h"
 #include "Timer.h"
 #include "Player.h"
 
-PlayerController::PlayerController(PlayerList& players)
+PlayerController::PlayerController(PlayerList& players, const BoardController& boardController, GameClockPtr clock)
+	: mClock(clock)
+	, mTimerWheel(clock->Now())
 {
 	for (auto& p : players)
 	{
-		mPlayerMap[p->GetPlayerID()] = std::move(p);
+		const auto playerID = p->GetPlayerID();
+		auto& timer = p->GetTimer();
+		mTimers[timer.GetObjectID()] = &timer;
+		mTerritoryMaps[playerID] = std::make_unique<TerritoryMap>(boardController);
+		mPlayerMap[playerID] = std::move(p);
 	}
 }
 
@@ -30,12 +39,22 @@ PlayerController::ObserveTimers(ObserverPtr obs)
 void
 PlayerController::Tick()
 {
-	for (const auto& player : mPlayerMap)
+	//finished timers notify their observers, which can start them again, so
+	// the wheel is done with them before any of that happens
+	mExpiredTimers.clear();
+	mTimerWheel.Advance(mClock->Now(), mExpiredTimers);
+	for (auto timerID : mExpiredTimers)
 	{
-		player.second->GetTimer().Tick();
+		mTimers.at(timerID)->OnTimerFinished();
 	}
 }
 
+std::chrono::steady_clock::time_point
+PlayerController::GetNextTimerDeadline() const
+{
+	return mTimerWheel.GetNextDeadline();
+}
+
 Player&
 PlayerController::GetPlayer(int playerID)
 {
@@ -60,16 +79,46 @@ PlayerController::GetPlayerTiles(int playerID) const
 	return GetConstPlayer(playerID).GetPlayerTileIDs();
 }
 
+const TerritoryMap&
+PlayerController::GetTerritoryMap(int playerID) const
+{
+	const auto territoryHandle = mTerritoryMaps.find(playerID);
+	assert(territoryHandle != mTerritoryMaps.end());
+
+	return *territoryHandle->second;
+}
+
 void
 PlayerController::AddTileToPlayer(int tileID, int playerID)
 {
 	GetPlayer(playerID).AddTile(tileID);
+	mTerritoryMaps[playerID]->AddTile(tileID);
 }
 
 void
 PlayerController::RemoveTileFromPlayer(int tileID, int playerID)
 {
 	GetPlayer(playerID).RemoveTile(tileID);
+	mTerritoryMaps[playerID]->RemoveTile(tileID);
+}
+
+int
+PlayerController::GetPlayerTerritoryID(int playerID, int tileID) const
+{
+	return GetTerritoryMap(playerID).GetTerritoryID(tileID);
+}
+
+bool
+PlayerController::ArePlayerTilesConnected(int playerID, int tileA, int tileB) const
+{
+	return GetTerritoryMap(playerID).AreConnected(tileA, tileB);
+}
+
+TileIDSet
+PlayerController::GetConnectedPlayerTiles(int playerID, int tileID) const
+{
+	const auto connectedTiles = GetTerritoryMap(playerID).GetConnectedTiles(tileID);
+	return TileIDSet(connectedTiles.begin(), connectedTiles.end());
 }
 
 GameObjectSet
@@ -101,10 +150,26 @@ PlayerController::MovePlayerTimer(int playerID, int selectedTileID)
 	return true;
 }
 
+bool
+PlayerController::IsPlayerTimerBusy(int playerID) const
+{
+	return GetConstPlayer(playerID).GetTimer().IsBusy();
+}
+
 void
 PlayerController::FlipPlayerTimer(int playerID, TimerResultPtr result)
 {
-	GetPlayer(playerID).GetTimer().OnTimerStart(result);
+	auto& timer = GetPlayer(playerID).GetTimer();
+	timer.OnTimerStart(result, mClock->Now());
+	mTimerWheel.Schedule(timer.GetObjectID(), timer.GetDeadline());
+}
+
+void
+PlayerController::CancelPlayerTimer(int playerID)
+{
+	auto& timer = GetPlayer(playerID).GetTimer();
+	timer.Cancel();
+	mTimerWheel.Cancel(timer.GetObjectID());
 }
 
 void
@@ -125,4 +190,44 @@ PlayerController::GiveBills(int playerIDOfGiver, int playerIDOfTaker, int amount
 
 	givingPlayer.TakeBills(amount);
 	takingPlayer.AddBills(amount);
-}
\ No newline at end of file
+}
+
+std::vector<int>
+PlayerController::GetPlayerIDs() const
+{
+	//in order, so a snapshot's players always come out the same way round
+	std::vector<int> playerIDs;
+	for (const auto& player : mPlayerMap)
+		playerIDs.push_back(player.first);
+	std::sort(playerIDs.begin(), playerIDs.end());
+	return playerIDs;
+}
+
+void
+PlayerController::SaveState(SnapshotWriter& writer) const
+{
+	const auto playerIDs = GetPlayerIDs();
+	writer.WriteVector(playerIDs);
+	for (auto playerID : playerIDs)
+	{
+		GetConstPlayer(playerID).SaveState(writer);
+		GetTerritoryMap(playerID).SaveState(writer);
+	}
+
+	mTimerWheel.SaveState(writer);
+}
+
+void
+PlayerController::LoadState(SnapshotReader& reader)
+{
+	std::vector<int> playerIDs;
+	reader.ReadVector(playerIDs);
+	assert(playerIDs == GetPlayerIDs());
+	for (auto playerID : playerIDs)
+	{
+		GetPlayer(playerID).LoadState(reader);
+		mTerritoryMaps[playerID]->LoadState(reader);
+	}
+
+	mTimerWheel.LoadState(reader);
+}
@@ -1,21 +1,32 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
+#include "GameClock.h"
 #include "Observer.h"
+#include "TimerWheel.h"
 
+class BoardController;
 class GameObject;
 class Observer;
 class Player;
+class SnapshotReader;
+class SnapshotWriter;
+class TerritoryMap;
+class TimerObject;
 
 using GameObjectPtr = std::shared_ptr < GameObject >;
 using GameObjectSet = std::unordered_set < GameObjectPtr >;
 using PlayerPtr = std::unique_ptr < Player > ;
 using PlayerList = std::vector < PlayerPtr >;
 using PlayerMap = std::unordered_map < int, PlayerPtr > ;
+using TileIDList = std::vector < int >;
 using TileIDSet = std::unordered_set < int >;
+using TerritoryMapPtr = std::unique_ptr < TerritoryMap >;
+using TerritoryMapMap = std::unordered_map < int, TerritoryMapPtr >;
 
 class PlayerController
 {
@@ -23,13 +34,19 @@ public:
 	PlayerController(const PlayerController&) = delete;
 	PlayerController& operator=(const PlayerController& rhs) = delete;
 
-	PlayerController(PlayerList& players);
+	//timers run on the real clock unless given another
+	PlayerController(PlayerList& players, const BoardController& boardController, GameClockPtr clock = std::make_shared<RealGameClock>());
 	~PlayerController();
 
 	void ObserveTimers(ObserverPtr obs);
 
+	//finishes the timers whose deadlines have passed, only those are looked at
 	void Tick();
 
+	//the soonest a busy player timer finishes, time_point::max() if none are busy
+	std::chrono::steady_clock::time_point GetNextTimerDeadline() const;
+
+	bool IsPlayerTimerBusy(int playerID) const;
 	void FlipPlayerTimer(int playerID, TimerResultPtr result);
 	void CancelPlayerTimer(int playerID);
 	bool MovePlayerTimer(int playerID, int selectedTileID);
@@ -41,11 +58,30 @@ public:
 	void AddTileToPlayer(int tileID, int playerID);
 	void RemoveTileFromPlayer(int tileID, int playerID);
 
+	int GetPlayerTerritoryID(int playerID, int tileID) const;
+	bool ArePlayerTilesConnected(int playerID, int tileA, int tileB) const;
+	TileIDSet GetConnectedPlayerTiles(int playerID, int tileID) const;
+
 	void GiveBills(int playerIDOfGiver, int playerIDOfTaker, int amount);
 
+	//every player, their territories and the running timers. Observers aren't
+	// part of it, whoever was watching the timers still is after a restore
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
 private:
 	Player& GetPlayer(int playerID);
 	const Player& GetConstPlayer(int playerID) const;
+	const TerritoryMap& GetTerritoryMap(int playerID) const;
+	std::vector<int> GetPlayerIDs() const;
 
 	PlayerMap mPlayerMap;
+	TerritoryMapMap mTerritoryMaps;
+
+	GameClockPtr mClock;
+
+	//every busy timer's deadline, by timer ID
+	TimerWheel mTimerWheel;
+	std::unordered_map<int, TimerObject*> mTimers;
+	std::vector<int> mExpiredTimers;
 };
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "ProgramCache.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+	//file layout: magic, version, key, format, binary size, binary
+	const char FILE_MAGIC[4] = { 'F', 'C', 'P', 'B' };
+	const std::uint32_t FILE_VERSION = 1;
+
+	//drivers' binaries are tens to hundreds of KB, anything this big is a bad file
+	const std::uint32_t MAX_BINARY_SIZE = 64 * 1024 * 1024;
+
+	const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+	const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+	void
+	HashBytes(std::uint64_t& hash, const void* data, size_t size)
+	{
+		const auto bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= FNV_PRIME;
+		}
+	}
+
+	template <typename T>
+	void
+	WriteValue(std::ofstream& out, const T& value)
+	{
+		out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template <typename T>
+	bool
+	ReadValue(std::ifstream& in, T& value)
+	{
+		return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+}
+
+ProgramCache::ProgramCache(const std::string& directory)
+	: mDirectory(directory)
+{
+}
+
+std::uint64_t
+ProgramCache::HashParts(const std::vector<std::string>& parts)
+{
+	std::uint64_t hash = FNV_OFFSET_BASIS;
+	for (const auto& part : parts)
+	{
+		const std::uint64_t size = part.size();
+		HashBytes(hash, &size, sizeof(size));
+		HashBytes(hash, part.data(), part.size());
+	}
+	return hash;
+}
+
+bool
+ProgramCache::IsEnabled() const
+{
+	return !mDirectory.empty();
+}
+
+std::string
+ProgramCache::GetPath(std::uint64_t key) const
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+	return mDirectory + "/" + name;
+}
+
+bool
+ProgramCache::Load(std::uint64_t key, std::uint32_t& format, std::vector<char>& binary) const
+{
+	if (!IsEnabled())
+		return false;
+
+	std::ifstream in(GetPath(key), std::ios::binary);
+	if (!in)
+		return false;
+
+	char magic[sizeof(FILE_MAGIC)];
+	std::uint32_t version = 0;
+	std::uint64_t fileKey = 0;
+	std::uint32_t size = 0;
+	if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 ||
+		!ReadValue(in, version) || version != FILE_VERSION ||
+		!ReadValue(in, fileKey) || fileKey != key ||
+		!ReadValue(in, format) ||
+		!ReadValue(in, size) || size == 0 || size > MAX_BINARY_SIZE)
+		return false;
+
+	binary.resize(size);
+	return static_cast<bool>(in.read(binary.data(), size));
+}
+
+bool
+ProgramCache::Store(std::uint64_t key, std::uint32_t format, const std::vector<char>& binary) const
+{
+	if (!IsEnabled() || binary.empty() || binary.size() > MAX_BINARY_SIZE || !MakeDirectory())
+		return false;
+
+	const auto path = GetPath(key);
+	//a name of its own, in case another instance is storing the same program
+	const auto tempPath = path + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+
+		out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+		WriteValue(out, FILE_VERSION);
+		WriteValue(out, key);
+		WriteValue(out, format);
+		WriteValue(out, static_cast<std::uint32_t>(binary.size()));
+		out.write(binary.data(), binary.size());
+		if (!out)
+		{
+			out.close();
+			std::remove(tempPath.c_str());
+			return false;
+		}
+	}
+
+	//rename won't replace an existing file on Windows
+	std::remove(path.c_str());
+	if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+	{
+		std::remove(tempPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool
+ProgramCache::MakeDirectory() const
+{
+#ifdef _WIN32
+	const int result = _mkdir(mDirectory.c_str());
+#else
+	const int result = mkdir(mDirectory.c_str(), 0755);
+#endif
+	return result == 0 || errno == EEXIST;
+}
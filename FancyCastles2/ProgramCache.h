@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Linked shader programs saved to disk so later runs can skip compiling and
+// linking. Each program is one file in the cache directory named after a key
+// hashed from everything that went into it: shader sources, output names and
+// the driver. A changed shader or driver gets a new key, stale files are
+// never read back.
+//Nothing here touches GL, the renderer gets and sets the binaries
+class ProgramCache
+{
+public:
+	//an empty directory turns the cache off
+	explicit ProgramCache(const std::string& directory);
+
+	//FNV-1a over the parts, each one length prefixed so moving text from one
+	// part to the next changes the hash
+	static std::uint64_t HashParts(const std::vector<std::string>& parts);
+
+	bool IsEnabled() const;
+	std::string GetPath(std::uint64_t key) const;
+
+	//false if there's no usable file for the key
+	bool Load(std::uint64_t key, std::uint32_t& format, std::vector<char>& binary) const;
+
+	//written to a temporary file and renamed into place, so another instance
+	// starting up at the same time never reads half a binary
+	bool Store(std::uint64_t key, std::uint32_t format, const std::vector<char>& binary) const;
+
+private:
+	bool MakeDirectory() const;
+
+	std::string mDirectory;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+//Counter based random numbers: the n-th value of a stream is a hash of
+// (seed, stream, n), so any stream can be started anywhere without
+// running the ones before it and results don't depend on thread count
+class CounterRandom
+{
+public:
+	CounterRandom(std::uint64_t seed, std::uint64_t stream)
+		: mKey(Mix(seed ^ Mix(stream + 0x632be59bd9b4e019ull))), mCounter(0), mBits(0), mBitsLeft(0)
+	{
+	}
+
+	std::uint64_t Next()
+	{
+		return Mix(mKey + 0x9e3779b97f4a7c15ull * ++mCounter);
+	}
+
+	//uniform in [0, bound), rejects the sliver of values that would bias the low end
+	std::uint64_t NextBelow(std::uint64_t bound)
+	{
+		const std::uint64_t threshold = (0 - bound) % bound;
+		for (;;)
+		{
+			const auto value = Next();
+			if (value >= threshold)
+				return value % bound;
+		}
+	}
+
+	bool NextBit()
+	{
+		if (mBitsLeft == 0)
+		{
+			mBits = Next();
+			mBitsLeft = 64;
+		}
+
+		const bool bit = (mBits & 1) != 0;
+		mBits >>= 1;
+		--mBitsLeft;
+		return bit;
+	}
+
+	//splitmix64 finalizer
+	static std::uint64_t Mix(std::uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+		return value ^ (value >> 31);
+	}
+
+private:
+	std::uint64_t mKey;
+	std::uint64_t mCounter;
+	std::uint64_t mBits;
+	int mBitsLeft;
+};
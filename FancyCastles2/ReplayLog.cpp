@@ -0,0 +1,489 @@
+#include "ReplayLog.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+
+#include "Commands.h"
+#include "GameSimulation.h"
+#include "PlayerController.h"
+#include "Timer.h"
+
+namespace
+{
+	const char REPLAY_MAGIC[4] = { 'F', 'C', 'R', 'L' };
+	const std::uint64_t REPLAY_VERSION = 1;
+
+	void
+	WriteFloat(ReplayBytes& out, float value)
+	{
+		std::uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		for (int i = 0; i < 4; ++i)
+			out.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+	}
+
+	bool
+	ReadFloat(const std::uint8_t*& pos, const std::uint8_t* end, float& value)
+	{
+		if (end - pos < 4)
+			return false;
+
+		std::uint32_t bits = 0;
+		for (int i = 0; i < 4; ++i)
+			bits |= static_cast<std::uint32_t>(*pos++) << (8 * i);
+		std::memcpy(&value, &bits, sizeof(value));
+		return true;
+	}
+
+	bool
+	ReadInt(const std::uint8_t*& pos, const std::uint8_t* end, int& value)
+	{
+		std::uint64_t raw;
+		if (!ReplayLog::ReadVarint(pos, end, raw))
+			return false;
+		value = static_cast<int>(ReplayLog::UnZigZag(raw));
+		return true;
+	}
+
+	void
+	WriteInt(ReplayBytes& out, int value)
+	{
+		ReplayLog::WriteVarint(out, ReplayLog::ZigZag(value));
+	}
+
+	bool
+	ReadEvent(const std::uint8_t*& pos, const std::uint8_t* end, std::chrono::microseconds previousTime, ReplayEvent& event)
+	{
+		std::uint64_t type, delta;
+		if (!ReplayLog::ReadVarint(pos, end, type) || type >= static_cast<std::uint64_t>(ReplayEventType::NUMTYPES))
+			return false;
+		if (!ReplayLog::ReadVarint(pos, end, delta))
+			return false;
+
+		event = ReplayEvent();
+		event.mType = static_cast<ReplayEventType>(type);
+		event.mTime = previousTime + std::chrono::microseconds(delta);
+
+		switch (event.mType)
+		{
+		case ReplayEventType::TILE_ASSIGNED:
+			return ReadInt(pos, end, event.mTileID) && ReadInt(pos, end, event.mPlayerID);
+		case ReplayEventType::MOVE_SELECTION:
+			return ReadInt(pos, end, event.mOffset.r) && ReadInt(pos, end, event.mOffset.q);
+		case ReplayEventType::SELECT_TILE:
+			return ReadInt(pos, end, event.mTileID);
+		case ReplayEventType::PAN_CAMERA:
+			return ReadFloat(pos, end, event.mX) && ReadFloat(pos, end, event.mY);
+		case ReplayEventType::ZOOM_CAMERA:
+			return ReadFloat(pos, end, event.mX);
+		case ReplayEventType::CHANGE_PLAYER:
+			return ReadInt(pos, end, event.mPlayerID);
+		case ReplayEventType::TIMER_FINISHED:
+		{
+			int objectType;
+			if (!ReadInt(pos, end, event.mPlayerID) || !ReadInt(pos, end, event.mTileID) ||
+				!ReadInt(pos, end, event.mQuantity) || !ReadInt(pos, end, objectType))
+				return false;
+			event.mObjectType = static_cast<GameObjectType>(objectType);
+			return true;
+		}
+		default:
+			return true;
+		}
+	}
+
+	//turns a command event back into the command that was recorded, null for other events
+	std::unique_ptr<Command>
+	MakeCommand(const ReplayEvent& event)
+	{
+		switch (event.mType)
+		{
+		case ReplayEventType::MOVE_SELECTION:
+			return std::make_unique<MoveSelectionCommand>(event.mOffset.r, event.mOffset.q);
+		case ReplayEventType::SELECT_TILE:
+			return std::make_unique<SelectTileCommand>(event.mTileID);
+		case ReplayEventType::HARVEST:
+			return std::make_unique<HarvestCommand>();
+		case ReplayEventType::BUILD:
+			return std::make_unique<BuildCommand>();
+		case ReplayEventType::PAN_CAMERA:
+			return std::make_unique<PanCameraCommand>(event.mX, event.mY);
+		case ReplayEventType::ZOOM_CAMERA:
+			return std::make_unique<ZoomCameraCommand>(event.mX);
+		case ReplayEventType::CHANGE_PLAYER:
+			return std::make_unique<ChangePlayerCommand>(event.mPlayerID);
+		case ReplayEventType::EXIT_GAME:
+			return std::make_unique<ExitGameCommand>();
+		default:
+			return nullptr;
+		}
+	}
+
+	//keeps the timer results a replay produces to check against the log
+	class TimerResultLog : public Observer
+	{
+	public:
+		void OnNotify(TimerResultPtr result) override { mResults.push_back(*result); }
+		void OnNotify(Command*) override { }
+
+		std::vector<TimerResult> mResults;
+	};
+}
+
+void
+ReplayLog::WriteVarint(ReplayBytes& out, std::uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back(static_cast<std::uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool
+ReplayLog::ReadVarint(const std::uint8_t*& pos, const std::uint8_t* end, std::uint64_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64 && pos != end; shift += 7)
+	{
+		const auto byte = *pos++;
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+void
+ReplayLog::WriteHeader(ReplayBytes& out, const ReplayHeader& header)
+{
+	out.insert(out.end(), std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC));
+	WriteVarint(out, REPLAY_VERSION);
+	WriteVarint(out, header.mSeed);
+	WriteInt(out, header.mNumTilesPerType);
+	WriteInt(out, header.mNumPlayers);
+	WriteInt(out, header.mNumStartingBills);
+	WriteInt(out, header.mHarvestRateBonus);
+}
+
+void
+ReplayLog::WriteEvent(ReplayBytes& out, const ReplayEvent& event, std::chrono::microseconds previousTime)
+{
+	assert(event.mTime >= previousTime);
+	WriteVarint(out, static_cast<std::uint64_t>(event.mType));
+	WriteVarint(out, static_cast<std::uint64_t>((event.mTime - previousTime).count()));
+
+	switch (event.mType)
+	{
+	case ReplayEventType::TILE_ASSIGNED:
+		WriteInt(out, event.mTileID);
+		WriteInt(out, event.mPlayerID);
+		break;
+	case ReplayEventType::MOVE_SELECTION:
+		WriteInt(out, event.mOffset.r);
+		WriteInt(out, event.mOffset.q);
+		break;
+	case ReplayEventType::SELECT_TILE:
+		WriteInt(out, event.mTileID);
+		break;
+	case ReplayEventType::PAN_CAMERA:
+		WriteFloat(out, event.mX);
+		WriteFloat(out, event.mY);
+		break;
+	case ReplayEventType::ZOOM_CAMERA:
+		WriteFloat(out, event.mX);
+		break;
+	case ReplayEventType::CHANGE_PLAYER:
+		WriteInt(out, event.mPlayerID);
+		break;
+	case ReplayEventType::TIMER_FINISHED:
+		WriteInt(out, event.mPlayerID);
+		WriteInt(out, event.mTileID);
+		WriteInt(out, event.mQuantity);
+		WriteInt(out, static_cast<int>(event.mObjectType));
+		break;
+	default:
+		break;
+	}
+}
+
+bool
+ReplayLog::Read(const ReplayBytes& bytes, ReplayHeader& header, ReplayEventList& events)
+{
+	const std::uint8_t* pos = bytes.data();
+	const std::uint8_t* end = pos + bytes.size();
+	if (bytes.size() < sizeof(REPLAY_MAGIC) || !std::equal(std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC), pos))
+		return false;
+	pos += sizeof(REPLAY_MAGIC);
+
+	std::uint64_t version;
+	if (!ReadVarint(pos, end, version) || version != REPLAY_VERSION)
+		return false;
+	if (!ReadVarint(pos, end, header.mSeed) || !ReadInt(pos, end, header.mNumTilesPerType) ||
+		!ReadInt(pos, end, header.mNumPlayers) || !ReadInt(pos, end, header.mNumStartingBills) ||
+		!ReadInt(pos, end, header.mHarvestRateBonus))
+		return false;
+
+	events.clear();
+	std::chrono::microseconds time(0);
+	while (pos != end)
+	{
+		ReplayEvent event;
+		if (!ReadEvent(pos, end, time, event))
+			return false;
+		time = event.mTime;
+		events.push_back(event);
+	}
+	return true;
+}
+
+bool
+ReplayLog::Read(std::istream& in, ReplayHeader& header, ReplayEventList& events)
+{
+	const ReplayBytes bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	return Read(bytes, header, events);
+}
+
+ReplayResult
+ReplayLog::Play(const ReplayHeader& header, const ReplayEventList& events)
+{
+	//the tiles come from the log rather than being dealt
+	SimulationSettings settings;
+	settings.mSeed = header.mSeed;
+	settings.mNumTilesPerType = header.mNumTilesPerType;
+	settings.mNumPlayers = header.mNumPlayers;
+	settings.mNumStartingBills = header.mNumStartingBills;
+	settings.mHarvestRateBonus = header.mHarvestRateBonus;
+	settings.mTilesPerPlayer = 0;
+	GameSimulation sim(settings);
+
+	auto timerResults = std::make_shared<TimerResultLog>();
+	sim.GetPlayerController().ObserveTimers(timerResults);
+
+	ReplayResult result;
+	std::vector<TimerResult> recordedTimers;
+	const auto start = sim.GetClock().Now();
+	for (const auto& event : events)
+	{
+		sim.GetClock().AdvanceTo(start + event.mTime);
+
+		if (event.mType == ReplayEventType::TILE_ASSIGNED)
+		{
+			sim.GetPlayerController().AddTileToPlayer(event.mTileID, event.mPlayerID);
+		}
+		else if (event.mType == ReplayEventType::TIMER_FINISHED)
+		{
+			//the recorded game started its timers a moment after the command was logged,
+			// so a timer can be due a hair after the log says it finished
+			recordedTimers.emplace_back(event.mObjectType, event.mTileID, event.mQuantity, event.mPlayerID);
+			sim.AdvanceTo(sim.GetClock().Now());
+			const bool isPlayer = event.mPlayerID >= 0 && event.mPlayerID < header.mNumPlayers;
+			while (isPlayer && sim.GetPlayerController().IsPlayerTimerBusy(event.mPlayerID))
+				sim.AdvanceTo(sim.GetPlayerController().GetNextTimerDeadline());
+		}
+		else if (auto command = MakeCommand(event))
+		{
+			sim.SendCommand(*command);
+			result.mNumCommands++;
+		}
+	}
+
+	result.mNumTimersRecorded = static_cast<int>(recordedTimers.size());
+	result.mNumTimersFinished = static_cast<int>(timerResults->mResults.size());
+	result.mNumTimerMismatches = std::abs(result.mNumTimersRecorded - result.mNumTimersFinished);
+	for (int i = 0; i < std::min(result.mNumTimersRecorded, result.mNumTimersFinished); ++i)
+	{
+		const auto& recorded = recordedTimers[i];
+		const auto& replayed = timerResults->mResults[i];
+		if (recorded.mPlayerID != replayed.mPlayerID || recorded.mResultLocation != replayed.mResultLocation ||
+			recorded.mQuantity != replayed.mQuantity || recorded.mResultObjectType != replayed.mResultObjectType)
+			result.mNumTimerMismatches++;
+	}
+
+	for (int playerID = 0; playerID < header.mNumPlayers; ++playerID)
+		result.mResourcesPerPlayer.push_back(sim.GetNumResources(playerID));
+
+	return result;
+}
+
+ReplayWriter::ReplayWriter(std::ostream& out)
+	: mOut(out)
+	, mNumAppended(0)
+	, mNumWritten(0)
+	, mClosing(false)
+{
+	mThread = std::thread(&ReplayWriter::WriteLoop, this);
+}
+
+ReplayWriter::~ReplayWriter()
+{
+	Close();
+}
+
+void
+ReplayWriter::Append(const ReplayBytes& bytes)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		assert(!mClosing);
+		mPending.insert(mPending.end(), bytes.begin(), bytes.end());
+		mNumAppended += bytes.size();
+	}
+	mHasPending.notify_one();
+}
+
+void
+ReplayWriter::Flush()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	const auto target = mNumAppended;
+	mWritten.wait(lock, [&] { return mNumWritten >= target; });
+}
+
+void
+ReplayWriter::Close()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mClosing)
+			return;
+		mClosing = true;
+	}
+	mHasPending.notify_one();
+	mThread.join();
+}
+
+void
+ReplayWriter::WriteLoop()
+{
+	//swap the pending bytes out and write them without holding the lock,
+	// so appending only ever waits for a swap
+	ReplayBytes writing;
+	std::unique_lock<std::mutex> lock(mMutex);
+	for (;;)
+	{
+		mHasPending.wait(lock, [this] { return !mPending.empty() || mClosing; });
+		if (mPending.empty())
+			return;
+
+		writing.clear();
+		writing.swap(mPending);
+		lock.unlock();
+
+		mOut.write(reinterpret_cast<const char*>(writing.data()), writing.size());
+		mOut.flush();
+
+		lock.lock();
+		mNumWritten += writing.size();
+		mWritten.notify_all();
+	}
+}
+
+ReplayRecorder::ReplayRecorder(ReplayWriter& writer, GameClockPtr clock, const ReplayHeader& header)
+	: mWriter(writer)
+	, mClock(clock)
+	, mStart(clock->Now())
+	, mLastTime(0)
+	, mNumEvents(0)
+{
+	ReplayLog::WriteHeader(mEventBytes, header);
+	mWriter.Append(mEventBytes);
+}
+
+int
+ReplayRecorder::GetNumEvents() const
+{
+	return mNumEvents;
+}
+
+void
+ReplayRecorder::Record(ReplayEvent& event)
+{
+	event.mTime = std::max(mLastTime, std::chrono::duration_cast<std::chrono::microseconds>(mClock->Now() - mStart));
+
+	mEventBytes.clear();
+	ReplayLog::WriteEvent(mEventBytes, event, mLastTime);
+	mWriter.Append(mEventBytes);
+
+	mLastTime = event.mTime;
+	mNumEvents++;
+}
+
+void
+ReplayRecorder::RecordTileAssigned(int tileID, int playerID)
+{
+	ReplayEvent event;
+	event.mType = ReplayEventType::TILE_ASSIGNED;
+	event.mTileID = tileID;
+	event.mPlayerID = playerID;
+	Record(event);
+}
+
+void
+ReplayRecorder::OnNotify(TimerResultPtr result)
+{
+	ReplayEvent event;
+	event.mType = ReplayEventType::TIMER_FINISHED;
+	event.mPlayerID = result->mPlayerID;
+	event.mTileID = result->mResultLocation;
+	event.mQuantity = result->mQuantity;
+	event.mObjectType = result->mResultObjectType;
+	Record(event);
+}
+
+void
+ReplayRecorder::OnNotify(Command* cmd)
+{
+	ReplayEvent event;
+	if (auto moveCmd = dynamic_cast<MoveSelectionCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::MOVE_SELECTION;
+		event.mOffset = moveCmd->GetOffset();
+	}
+	else if (auto selectCmd = dynamic_cast<SelectTileCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::SELECT_TILE;
+		event.mTileID = selectCmd->GetTileID();
+	}
+	else if (dynamic_cast<HarvestCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::HARVEST;
+	}
+	else if (dynamic_cast<BuildCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::BUILD;
+	}
+	else if (auto panCmd = dynamic_cast<PanCameraCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::PAN_CAMERA;
+		event.mX = panCmd->GetDX();
+		event.mY = panCmd->GetDY();
+	}
+	else if (auto zoomCmd = dynamic_cast<ZoomCameraCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::ZOOM_CAMERA;
+		event.mX = zoomCmd->GetFactor();
+	}
+	else if (auto changePlayerCmd = dynamic_cast<ChangePlayerCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::CHANGE_PLAYER;
+		event.mPlayerID = changePlayerCmd->GetPlayerID();
+	}
+	else if (dynamic_cast<ExitGameCommand*>(cmd))
+	{
+		event.mType = ReplayEventType::EXIT_GAME;
+	}
+	else
+	{
+		return;
+	}
+
+	Record(event);
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GameClock.h"
+#include "GameObject.h"
+#include "Observer.h"
+#include "TileTraits.h"
+
+//A recorded game is the board it was played on followed by every command the
+// GameManager acted on and every timer that finished, in the order they happened.
+//Each event is a type tag, the microseconds since the event before it and its
+// fields, all as LEB128 varints (signed ones zigzagged) except camera moves,
+// which keep their floats as 4 raw bytes. Most events take 2-4 bytes.
+//Picks are recorded as the SelectTileCommand they resolved to, so a replay
+// doesn't need a screen or the mouse position
+
+struct ReplayHeader
+{
+	std::uint64_t mSeed;	//for Board::MakeBoard
+	int mNumTilesPerType;
+	int mNumPlayers;
+	int mNumStartingBills;
+	int mHarvestRateBonus;	//see SimulationSettings, 0 for a real game
+
+	ReplayHeader() : mSeed(0), mNumTilesPerType(0), mNumPlayers(0), mNumStartingBills(0), mHarvestRateBonus(0) { }
+};
+
+enum class ReplayEventType : std::uint8_t
+{
+	TILE_ASSIGNED,
+	MOVE_SELECTION,
+	SELECT_TILE,
+	HARVEST,
+	BUILD,
+	PAN_CAMERA,
+	ZOOM_CAMERA,
+	CHANGE_PLAYER,
+	EXIT_GAME,
+	TIMER_FINISHED,
+	NUMTYPES
+};
+
+//only the fields the event's type uses are filled in
+struct ReplayEvent
+{
+	ReplayEventType mType;
+	std::chrono::microseconds mTime;	//since recording started
+	int mPlayerID;		//CHANGE_PLAYER, TILE_ASSIGNED, TIMER_FINISHED
+	int mTileID;		//SELECT_TILE, TILE_ASSIGNED, TIMER_FINISHED
+	AxialCoord mOffset;	//MOVE_SELECTION
+	float mX, mY;		//PAN_CAMERA, ZOOM_CAMERA's factor is mX
+	int mQuantity;		//TIMER_FINISHED
+	GameObjectType mObjectType;	//TIMER_FINISHED
+
+	ReplayEvent()
+		: mType(ReplayEventType::NUMTYPES), mTime(0), mPlayerID(-1), mTileID(-1)
+		, mX(0.f), mY(0.f), mQuantity(0), mObjectType(GameObjectType::INVALID) { }
+};
+
+using ReplayEventList = std::vector < ReplayEvent > ;
+using ReplayBytes = std::vector < std::uint8_t > ;
+
+//what replaying a log did. Timers are finished when the log says they finished,
+// a mismatch means the replay's timer results differ from the recorded ones
+struct ReplayResult
+{
+	int mNumCommands;
+	int mNumTimersRecorded;
+	int mNumTimersFinished;
+	int mNumTimerMismatches;
+	std::vector<int> mResourcesPerPlayer;	//by player ID
+
+	ReplayResult() : mNumCommands(0), mNumTimersRecorded(0), mNumTimersFinished(0), mNumTimerMismatches(0) { }
+};
+
+namespace ReplayLog
+{
+	void WriteVarint(ReplayBytes& out, std::uint64_t value);
+	//false if the bytes run out before the varint ends
+	bool ReadVarint(const std::uint8_t*& pos, const std::uint8_t* end, std::uint64_t& value);
+
+	inline std::uint64_t ZigZag(std::int64_t value) { return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63); }
+	inline std::int64_t UnZigZag(std::uint64_t value) { return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1); }
+
+	void WriteHeader(ReplayBytes& out, const ReplayHeader& header);
+	void WriteEvent(ReplayBytes& out, const ReplayEvent& event, std::chrono::microseconds previousTime);
+
+	//false if the log is cut short or isn't one, events read before that are kept
+	bool Read(const ReplayBytes& bytes, ReplayHeader& header, ReplayEventList& events);
+	bool Read(std::istream& in, ReplayHeader& header, ReplayEventList& events);
+
+	//plays the log back on a GameSimulation as fast as it goes, no window or renderer
+	ReplayResult Play(const ReplayHeader& header, const ReplayEventList& events);
+}
+
+//Append only writer with the stream on its own thread, so recording never
+// waits on the disk. Appended bytes reach the stream in order
+class ReplayWriter
+{
+public:
+	ReplayWriter(const ReplayWriter&) = delete;
+	ReplayWriter& operator=(const ReplayWriter& rhs) = delete;
+
+	//out has to outlive the writer
+	explicit ReplayWriter(std::ostream& out);
+	~ReplayWriter();
+
+	void Append(const ReplayBytes& bytes);
+
+	//waits until everything appended so far has been written
+	void Flush();
+
+	//flushes and stops the writer thread, nothing can be appended after
+	void Close();
+
+private:
+	void WriteLoop();
+
+	std::ostream& mOut;
+	std::mutex mMutex;
+	std::condition_variable mHasPending;
+	std::condition_variable mWritten;
+	ReplayBytes mPending;
+	std::uint64_t mNumAppended;
+	std::uint64_t mNumWritten;
+	bool mClosing;
+	std::thread mThread;
+};
+
+//Records a game as it's played. GameManager hands it every command it acts on
+// and every timer result it gets, see GameManager::SetRecorder
+class ReplayRecorder : public Observer
+{
+public:
+	ReplayRecorder(const ReplayRecorder&) = delete;
+	ReplayRecorder& operator=(const ReplayRecorder& rhs) = delete;
+
+	//the header is written straight away and event times count from now
+	ReplayRecorder(ReplayWriter& writer, GameClockPtr clock, const ReplayHeader& header);
+
+	void OnNotify(TimerResultPtr result) override;
+	//commands that don't change the game, like picks that weren't resolved, are skipped
+	void OnNotify(Command* cmd) override;
+
+	//tiles handed out before the game starts
+	void RecordTileAssigned(int tileID, int playerID);
+
+	int GetNumEvents() const;
+
+private:
+	void Record(ReplayEvent& event);
+
+	ReplayWriter& mWriter;
+	GameClockPtr mClock;
+	GameClock::Clock::time_point mStart;
+	std::chrono::microseconds mLastTime;
+	ReplayBytes mEventBytes;
+	int mNumEvents;
+};
@@ -0,0 +1,313 @@
+#include "SoftwareBoardRenderer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FANCYCASTLES_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "Board.h"
+#include "HexLayout.h"
+#include "TilePalette.h"
+
+namespace
+{
+	const std::uint32_t BACKGROUND_COLOR = 0xff000000;
+
+	//the selected tile gets a white rim, the tile's own color shows inside this much of its hex
+	const std::uint32_t SELECTION_COLOR = 0xffffffff;
+	const float SELECTION_INNER_SIZE = 0.75f;
+}
+
+SoftwareBoardRenderer::SoftwareBoardRenderer(int width, int height)
+	: mWidth(width)
+	, mHeight(height)
+	, mImage(width * height, BACKGROUND_COLOR)
+	, mCamera(static_cast<float>(width), static_cast<float>(height))
+	, mMouseX(0.0)
+	, mMouseY(0.0)
+	, mSelectedTile(-1)
+	, mNeedsRedraw(true)
+	, mLastDrawnTiles(0)
+	, mNumFramesDrawn(0)
+{
+	assert(width > 0 && height > 0);
+}
+
+void
+SoftwareBoardRenderer::SetupTiles(const Board& gameBoard)
+{
+	mTileIndex = gameBoard.GetIndexView();
+
+	std::vector<AxialCoord> tileCoords;
+	for (int tileIndex = 0; tileIndex < gameBoard.GetNumTiles(); ++tileIndex)
+		tileCoords.push_back(gameBoard.GetTileCoord(tileIndex));
+
+	//same chunk order as the GL renderer, so culling works the same way
+	mChunks = BoardChunks(tileCoords);
+	mTileCenters.resize(2 * gameBoard.GetNumTiles());
+	mTileColors.resize(gameBoard.GetNumTiles());
+	for (int slot = 0; slot < gameBoard.GetNumTiles(); ++slot)
+	{
+		const auto tileIndex = mChunks.GetSlotTile(slot);
+		HexLayout::GetCartesianFromAxial(mTileCenters[2 * slot], mTileCenters[2 * slot + 1], tileCoords[tileIndex]);
+
+		const auto color = TilePalette::GetColor(gameBoard.GetTileType(tileIndex));
+		mTileColors[slot] = PackColor(color.r, color.g, color.b);
+	}
+
+	mSelectedTile = -1;
+	mNeedsRedraw = true;
+}
+
+void
+SoftwareBoardRenderer::Init()
+{
+}
+
+void
+SoftwareBoardRenderer::Cleanup()
+{
+}
+
+void
+SoftwareBoardRenderer::SetSelection(const AxialCoord& position)
+{
+	mSelectedTile = mTileIndex.IsPositionValid(position) ? mTileIndex.GetTileIndex(position) : -1;
+	mNeedsRedraw = true;
+}
+
+void
+SoftwareBoardRenderer::SetTileType(int tileID, ResourceType type)
+{
+	const auto color = TilePalette::GetColor(type);
+	mTileColors[mChunks.GetTileSlot(tileID)] = PackColor(color.r, color.g, color.b);
+	mNeedsRedraw = true;
+}
+
+void
+SoftwareBoardRenderer::PanCamera(float dxPixels, float dyPixels)
+{
+	mCamera.Pan(dxPixels, dyPixels);
+	mNeedsRedraw = true;
+}
+
+void
+SoftwareBoardRenderer::ZoomCamera(float factor)
+{
+	mCamera.ZoomAt(factor, mMouseX, mHeight - mMouseY);
+	mNeedsRedraw = true;
+}
+
+Camera&
+SoftwareBoardRenderer::GetCamera()
+{
+	return mCamera;
+}
+
+void
+SoftwareBoardRenderer::SetMousePosition(double x, double y)
+{
+	mMouseX = x;
+	mMouseY = y;
+}
+
+int
+SoftwareBoardRenderer::DoPick()
+{
+	return PickTile(mMouseX, mHeight - mMouseY);
+}
+
+int
+SoftwareBoardRenderer::PickTile(double windowX, double windowY) const
+{
+	float x, y;
+	mCamera.WindowToWorld(x, y, windowX, windowY);
+
+	AxialCoord position;
+	if (!HexLayout::PickHex(x, y, position) || !mTileIndex.IsPositionValid(position))
+		return INT_MAX;
+
+	return mTileIndex.GetTileIndex(position);
+}
+
+void
+SoftwareBoardRenderer::RenderScene()
+{
+	FillSpan(mImage.data(), static_cast<int>(mImage.size()), BACKGROUND_COLOR);
+
+	mChunks.FindVisibleSlots(mCamera.GetViewBounds(), mVisibleSlots);
+	mLastDrawnTiles = 0;
+
+	const int selectedSlot = mSelectedTile >= 0 ? mChunks.GetTileSlot(mSelectedTile) : -1;
+	for (const auto& range : mVisibleSlots)
+	{
+		for (int slot = range.mBegin; slot < range.mEnd; ++slot)
+		{
+			float windowX, windowY;
+			mCamera.WorldToWindow(windowX, windowY, mTileCenters[2 * slot], mTileCenters[2 * slot + 1]);
+
+			if (slot == selectedSlot)
+			{
+				DrawHex(windowX, windowY, HexLayout::HEX_SIZE, SELECTION_COLOR);
+				DrawHex(windowX, windowY, SELECTION_INNER_SIZE * HexLayout::HEX_SIZE, mTileColors[slot]);
+			}
+			else
+			{
+				DrawHex(windowX, windowY, HexLayout::HEX_SIZE, mTileColors[slot]);
+			}
+		}
+		mLastDrawnTiles += range.mEnd - range.mBegin;
+	}
+
+	mNumFramesDrawn++;
+	mNeedsRedraw = false;
+}
+
+void
+SoftwareBoardRenderer::DrawHex(float centerX, float centerY, float size, std::uint32_t color)
+{
+	//pointy topped: the middle half of the hex's height is full width, the
+	// width then narrows to nothing at the top and bottom corners.
+	//Pixel centers are at half pixels, rows are counted down from the top
+	float unitX, unitY;
+	float originX, originY;
+	mCamera.WorldToWindow(originX, originY, 0.f, 0.f);
+	mCamera.WorldToWindow(unitX, unitY, 1.f, 1.f);
+	const float pixelsPerUnitX = unitX - originX;
+	const float pixelsPerUnitY = unitY - originY;
+
+	const float halfHeight = size * pixelsPerUnitY;
+	const float inradius = HexLayout::SQRT_3_OVER_2 * size * pixelsPerUnitX;
+
+	const int rowBegin = std::max(0, static_cast<int>(std::ceil(mHeight - (centerY + halfHeight) - 0.5f)));
+	const int rowEnd = std::min(mHeight - 1, static_cast<int>(std::floor(mHeight - (centerY - halfHeight) - 0.5f)));
+	for (int row = rowBegin; row <= rowEnd; ++row)
+	{
+		const float dy = std::abs(mHeight - row - 0.5f - centerY) / halfHeight;
+		const float halfWidth = inradius * std::min(1.f, 2.f * (1.f - dy));
+		if (halfWidth < 0.f)
+			continue;
+
+		const int columnBegin = std::max(0, static_cast<int>(std::ceil(centerX - halfWidth - 0.5f)));
+		const int columnEnd = std::min(mWidth - 1, static_cast<int>(std::floor(centerX + halfWidth - 0.5f)));
+		if (columnBegin <= columnEnd)
+			FillSpan(&mImage[row * mWidth + columnBegin], columnEnd - columnBegin + 1, color);
+	}
+}
+
+void
+SoftwareBoardRenderer::FillSpan(std::uint32_t* pixels, int count, std::uint32_t color) const
+{
+#ifdef FANCYCASTLES_SSE2
+	//four pixels per store, then whatever is left one at a time
+	const __m128i color4 = _mm_set1_epi32(static_cast<int>(color));
+	int pixel = 0;
+	for (; pixel + 4 <= count; pixel += 4)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + pixel), color4);
+	for (; pixel < count; ++pixel)
+		pixels[pixel] = color;
+#else
+	std::fill(pixels, pixels + count, color);
+#endif
+}
+
+void
+SoftwareBoardRenderer::RunFrame(FramePacer::Clock::time_point nextDeadline)
+{
+	if (mNeedsRedraw)
+		RenderScene();
+
+	//no input can arrive, so with nothing scheduled there's nothing to wait for
+	if (nextDeadline != FramePacer::NoDeadline())
+		std::this_thread::sleep_until(nextDeadline);
+}
+
+void
+SoftwareBoardRenderer::RequestRedraw()
+{
+	mNeedsRedraw = true;
+}
+
+bool
+SoftwareBoardRenderer::NeedsRedraw() const
+{
+	return mNeedsRedraw;
+}
+
+int
+SoftwareBoardRenderer::GetWidth() const
+{
+	return mWidth;
+}
+
+int
+SoftwareBoardRenderer::GetHeight() const
+{
+	return mHeight;
+}
+
+const std::vector<std::uint32_t>&
+SoftwareBoardRenderer::GetImage() const
+{
+	return mImage;
+}
+
+std::uint32_t
+SoftwareBoardRenderer::GetPixel(int x, int y) const
+{
+	assert(x >= 0 && x < mWidth && y >= 0 && y < mHeight);
+	return mImage[y * mWidth + x];
+}
+
+bool
+SoftwareBoardRenderer::SaveImage(const std::string& filename) const
+{
+	std::ofstream out(filename, std::ios::binary);
+	if (!out)
+		return false;
+
+	out << "P6\n" << mWidth << " " << mHeight << "\n255\n";
+	std::vector<char> row(3 * mWidth);
+	for (int y = 0; y < mHeight; ++y)
+	{
+		for (int x = 0; x < mWidth; ++x)
+		{
+			const auto pixel = mImage[y * mWidth + x];
+			row[3 * x] = static_cast<char>(pixel & 0xff);
+			row[3 * x + 1] = static_cast<char>((pixel >> 8) & 0xff);
+			row[3 * x + 2] = static_cast<char>((pixel >> 16) & 0xff);
+		}
+		out.write(row.data(), row.size());
+	}
+
+	return static_cast<bool>(out);
+}
+
+int
+SoftwareBoardRenderer::GetLastDrawnTiles() const
+{
+	return mLastDrawnTiles;
+}
+
+int
+SoftwareBoardRenderer::GetNumFramesDrawn() const
+{
+	return mNumFramesDrawn;
+}
+
+std::uint32_t
+SoftwareBoardRenderer::PackColor(float r, float g, float b)
+{
+	const auto toByte = [](float channel)
+	{
+		return static_cast<std::uint32_t>(std::min(std::max(channel, 0.f), 1.f) * 255.f + 0.5f);
+	};
+	return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | 0xff000000;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BoardChunks.h"
+#include "BoardRenderer.h"
+#include "Camera.h"
+#include "TileRanges.h"
+
+//Draws the board on the CPU into an RGBA image, no window, GL context or GPU
+// needed. Hexes are filled a scanline at a time from the exact span the hex
+// covers on that row, so the output matches HexLayout's picking geometry.
+//The image is stored top row first, one 32 bit pixel per pixel with the bytes
+// in R, G, B, A order
+class SoftwareBoardRenderer : public BoardRenderer
+{
+public:
+	SoftwareBoardRenderer(int width, int height);
+
+	void SetupTiles(const Board& gameBoard) override;
+	void Init() override;
+	void Cleanup() override;
+
+	void SetSelection(const AxialCoord& position) override;
+	void SetTileType(int tileID, ResourceType type) override;
+
+	void PanCamera(float dxPixels, float dyPixels) override;
+	void ZoomCamera(float factor) override;
+
+	//moving the camera directly doesn't ask for a redraw, RenderScene or RequestRedraw after
+	Camera& GetCamera();
+
+	//there's no real mouse, DoPick and ZoomCamera use this. Window pixels with y
+	// measured down from the top, like GLFW's cursor position
+	void SetMousePosition(double x, double y);
+	int DoPick() override;
+	int PickTile(double windowX, double windowY) const;
+
+	void RenderScene() override;
+
+	//headless, so the only thing to wait for is nextDeadline
+	void RunFrame(FramePacer::Clock::time_point nextDeadline) override;
+	void RequestRedraw() override;
+	bool NeedsRedraw() const override;
+
+	int GetWidth() const;
+	int GetHeight() const;
+	const std::vector<std::uint32_t>& GetImage() const;
+
+	//pixel at column x, row y counted from the top
+	std::uint32_t GetPixel(int x, int y) const;
+
+	//binary PPM, readable by most image tools
+	bool SaveImage(const std::string& filename) const;
+
+	//tiles in the chunks the last frame drew, the rest were culled
+	int GetLastDrawnTiles() const;
+	int GetNumFramesDrawn() const;
+
+	static std::uint32_t PackColor(float r, float g, float b);
+
+private:
+	void DrawHex(float centerX, float centerY, float size, std::uint32_t color);
+	void FillSpan(std::uint32_t* pixels, int count, std::uint32_t color) const;
+
+	const int mWidth;
+	const int mHeight;
+	std::vector<std::uint32_t> mImage;
+
+	Camera mCamera;
+	double mMouseX;
+	double mMouseY;
+
+	//per draw slot, see BoardChunks
+	std::vector<float> mTileCenters;
+	std::vector<std::uint32_t> mTileColors;
+
+	BoardChunks mChunks;
+	TileSlotRangeList mVisibleSlots;
+	TileIndexView mTileIndex;
+	int mSelectedTile;
+
+	bool mNeedsRedraw;
+	int mLastDrawnTiles;
+	int mNumFramesDrawn;
+};
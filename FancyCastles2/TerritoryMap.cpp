@@ -0,0 +1,180 @@
+#include "TerritoryMap.h"
+
+#include <cassert>
+#include <utility>
+
+#include "BoardController.h"
+#include "GameSnapshot.h"
+
+TerritoryMap::TerritoryMap(const BoardController& boardController)
+	: mBoardController(boardController)
+	, mOwnedTiles(boardController.GetNumTiles())
+	, mParent(boardController.GetNumTiles(), -1)
+	, mTerritorySize(boardController.GetNumTiles(), 0)
+	, mNextInTerritory(boardController.GetNumTiles(), -1)
+{
+}
+
+bool
+TerritoryMap::OwnsTile(int tileID) const
+{
+	return mOwnedTiles.Test(tileID);
+}
+
+void
+TerritoryMap::ResetTile(int tileID)
+{
+	//a tile on its own is a territory of one
+	mParent[tileID] = tileID;
+	mTerritorySize[tileID] = 1;
+	mNextInTerritory[tileID] = tileID;
+}
+
+void
+TerritoryMap::AddTile(int tileID)
+{
+	if (tileID < 0 || tileID >= mOwnedTiles.GetNumTiles() || OwnsTile(tileID))
+		return;
+
+	mOwnedTiles.Set(tileID);
+	ResetTile(tileID);
+
+	for (auto neighbor : mBoardController.GetNeighbors(tileID))
+	{
+		if (OwnsTile(neighbor))
+			Union(tileID, neighbor);
+	}
+}
+
+void
+TerritoryMap::RemoveTile(int tileID)
+{
+	if (!OwnsTile(tileID))
+		return;
+
+	//splitting a union-find isn't possible, so pull out every tile of the
+	// territory this tile was in and join the ones that are left back up
+	mRebuildScratch.clear();
+	int curTile = tileID;
+	do
+	{
+		mRebuildScratch.push_back(curTile);
+		curTile = mNextInTerritory[curTile];
+	} while (curTile != tileID);
+
+	mOwnedTiles.Reset(tileID);
+	mParent[tileID] = -1;
+	mTerritorySize[tileID] = 0;
+	mNextInTerritory[tileID] = -1;
+
+	for (auto territoryTile : mRebuildScratch)
+	{
+		if (territoryTile != tileID)
+			ResetTile(territoryTile);
+	}
+
+	for (auto territoryTile : mRebuildScratch)
+	{
+		if (territoryTile == tileID)
+			continue;
+
+		for (auto neighbor : mBoardController.GetNeighbors(territoryTile))
+		{
+			if (OwnsTile(neighbor))
+				Union(territoryTile, neighbor);
+		}
+	}
+}
+
+int
+TerritoryMap::Find(int tileID) const
+{
+	while (mParent[tileID] != tileID)
+	{
+		mParent[tileID] = mParent[mParent[tileID]];
+		tileID = mParent[tileID];
+	}
+
+	return tileID;
+}
+
+void
+TerritoryMap::Union(int tileA, int tileB)
+{
+	auto rootA = Find(tileA);
+	auto rootB = Find(tileB);
+	if (rootA == rootB)
+		return;
+
+	//hang the smaller territory under the larger one
+	if (mTerritorySize[rootA] < mTerritorySize[rootB])
+		std::swap(rootA, rootB);
+
+	mParent[rootB] = rootA;
+	mTerritorySize[rootA] += mTerritorySize[rootB];
+
+	//swapping one successor in each circular list splices them into one
+	std::swap(mNextInTerritory[rootA], mNextInTerritory[rootB]);
+}
+
+int
+TerritoryMap::GetTerritoryID(int tileID) const
+{
+	if (!OwnsTile(tileID))
+		return -1;
+
+	return Find(tileID);
+}
+
+bool
+TerritoryMap::AreConnected(int tileA, int tileB) const
+{
+	const auto territoryA = GetTerritoryID(tileA);
+	return territoryA != -1 && territoryA == GetTerritoryID(tileB);
+}
+
+int
+TerritoryMap::GetTerritorySize(int tileID) const
+{
+	if (!OwnsTile(tileID))
+		return 0;
+
+	return mTerritorySize[Find(tileID)];
+}
+
+TileIDList
+TerritoryMap::GetConnectedTiles(int tileID) const
+{
+	TileIDList connectedTiles;
+	if (!OwnsTile(tileID))
+		return connectedTiles;
+
+	connectedTiles.reserve(GetTerritorySize(tileID));
+	int curTile = tileID;
+	do
+	{
+		connectedTiles.push_back(curTile);
+		curTile = mNextInTerritory[curTile];
+	} while (curTile != tileID);
+
+	assert(static_cast<int>(connectedTiles.size()) == GetTerritorySize(tileID));
+	return connectedTiles;
+}
+
+void
+TerritoryMap::SaveState(SnapshotWriter& writer) const
+{
+	mOwnedTiles.SaveState(writer);
+	writer.WriteVector(mParent);
+	writer.WriteVector(mTerritorySize);
+	writer.WriteVector(mNextInTerritory);
+}
+
+void
+TerritoryMap::LoadState(SnapshotReader& reader)
+{
+	mOwnedTiles.LoadState(reader);
+	reader.ReadVector(mParent);
+	reader.ReadVector(mTerritorySize);
+	reader.ReadVector(mNextInTerritory);
+}
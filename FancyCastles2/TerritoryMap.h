@@ -0,0 +1,57 @@
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+
+#include "TileBitSet.h"
+
+class BoardController;
+class SnapshotReader;
+class SnapshotWriter;
+
+using TileIDList = std::vector < int >;
+using TileIDSet = std::unordered_set < int >;
+
+//Keeps the tiles owned by one player grouped into connected territories.
+//Adding a tile unions it with any owned neighbors, removing a tile only
+// rebuilds the territory it was part of.
+class TerritoryMap
+{
+public:
+	TerritoryMap() = delete;
+	TerritoryMap& operator=(const TerritoryMap& rhs) = delete;
+
+	TerritoryMap(const BoardController& boardController);
+
+	void AddTile(int tileID);
+	void RemoveTile(int tileID);
+	bool OwnsTile(int tileID) const;
+
+	//ID of the territory the tile belongs to, -1 if the tile isn't owned
+	int GetTerritoryID(int tileID) const;
+	bool AreConnected(int tileA, int tileB) const;
+	int GetTerritorySize(int tileID) const;
+	TileIDList GetConnectedTiles(int tileID) const;
+
+	//the forest goes as it is, restoring doesn't redo any unions
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
+private:
+	int Find(int tileID) const;
+	void Union(int tileA, int tileB);
+	void ResetTile(int tileID);
+
+	const BoardController& mBoardController;
+
+	TileBitSet mOwnedTiles;
+
+	//union-find forest over tile IDs, with path halving on lookups
+	mutable TileIDList mParent;
+	TileIDList mTerritorySize;
+
+	//each territory's tiles form a circular list so they can be walked without a search
+	TileIDList mNextInTerritory;
+
+	TileIDList mRebuildScratch;
+};
@@ -1,15 +1,15 @@
 #include "Tile.h"
 
-Tile::Tile(ResourceType type, int tileID) : mTileType(type), mTileID(tileID), mHarvestRate(1)
+#include "Board.h"
+
+Tile::Tile(Board& board, int tileID) : mBoard(board), mTileID(tileID)
 {
-	if (mTileType == ResourceType::WATER)
-		mHarvestRate = 0;
 }
 
 ResourceType
 Tile::GetTileType() const
 {
-	return mTileType;
+	return mBoard.GetTileType(mTileID);
 }
 
 int
@@ -21,17 +21,11 @@ Tile::GetTileID() const
 int
 Tile::GetHarvestRate() const
 {
-	return mHarvestRate;
+	return mBoard.GetHarvestRate(mTileID);
 }
 
 void
 Tile::SetHarvestRate(int newRate)
 {
-	if (newRate <= 0)
-		return;
-
-	if (mTileType == ResourceType::WATER)
-		return;
-
-	mHarvestRate = newRate;
-}
\ No newline at end of file
+	mBoard.SetHarvestRate(mTileID, newRate);
+}
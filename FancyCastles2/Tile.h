@@ -2,11 +2,15 @@
 
 #include "TileTraits.h"
 
+class Board;
+
+//Lightweight handle to one tile. The tile's properties live in the
+// board's per-tile columns, this just reads and writes them by ID
 class Tile
 {
 
 public:
-	Tile(ResourceType type, int tileID);
+	Tile(Board& board, int tileID);
 
 	ResourceType GetTileType() const;
 
@@ -16,10 +20,6 @@ public:
 	void SetHarvestRate(int newRate);
 
 private:
-	//invariant properties
-	ResourceType mTileType;
+	Board& mBoard;
 	int mTileID;
-	
-	//variant properties
-	int mHarvestRate;
 };
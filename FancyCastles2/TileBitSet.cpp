@@ -0,0 +1,242 @@
+#include "TileBitSet.h"
+
+#include <algorithm>
+#include <cassert>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "GameSnapshot.h"
+
+namespace
+{
+	int
+	GetNumWordsForTiles(int numTiles)
+	{
+		return (numTiles + TileBitSet::BITS_PER_WORD - 1) / TileBitSet::BITS_PER_WORD;
+	}
+
+	TileBitSet::Word
+	GetLowBitMask(int numBits)
+	{
+		return numBits >= TileBitSet::BITS_PER_WORD ? ~TileBitSet::Word(0) : (TileBitSet::Word(1) << numBits) - 1;
+	}
+}
+
+TileBitSet::TileBitSet() : mNumTiles(0)
+{
+}
+
+TileBitSet::TileBitSet(int numTiles)
+	: mNumTiles(numTiles)
+	, mWords(GetNumWordsForTiles(numTiles), 0)
+{
+}
+
+TileBitSet::TileBitSet(int numTiles, const TileIDSet& tiles)
+	: TileBitSet(numTiles)
+{
+	for (auto tileID : tiles)
+		Set(tileID);
+}
+
+int
+TileBitSet::PopCount(Word word)
+{
+#if defined(_MSC_VER)
+	return static_cast<int>(__popcnt(static_cast<unsigned int>(word)) + __popcnt(static_cast<unsigned int>(word >> 32)));
+#else
+	return __builtin_popcountll(word);
+#endif
+}
+
+int
+TileBitSet::CountTrailingZeros(Word word)
+{
+	assert(word != 0);
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+		return static_cast<int>(index);
+	_BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+	return static_cast<int>(index) + 32;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+int
+TileBitSet::GetNumTiles() const
+{
+	return mNumTiles;
+}
+
+int
+TileBitSet::GetNumWords() const
+{
+	return static_cast<int>(mWords.size());
+}
+
+TileBitSet::Word
+TileBitSet::GetWord(int wordIndex) const
+{
+	return mWords[wordIndex];
+}
+
+void
+TileBitSet::Set(int tileID)
+{
+	assert(tileID >= 0 && tileID < mNumTiles);
+	mWords[tileID / BITS_PER_WORD] |= Word(1) << (tileID % BITS_PER_WORD);
+}
+
+void
+TileBitSet::Reset(int tileID)
+{
+	assert(tileID >= 0 && tileID < mNumTiles);
+	mWords[tileID / BITS_PER_WORD] &= ~(Word(1) << (tileID % BITS_PER_WORD));
+}
+
+bool
+TileBitSet::Test(int tileID) const
+{
+	if (tileID < 0 || tileID >= mNumTiles)
+		return false;
+
+	return (mWords[tileID / BITS_PER_WORD] >> (tileID % BITS_PER_WORD)) & 1;
+}
+
+void
+TileBitSet::Clear()
+{
+	std::fill(mWords.begin(), mWords.end(), 0);
+}
+
+int
+TileBitSet::Count() const
+{
+	int count = 0;
+	for (auto word : mWords)
+		count += PopCount(word);
+
+	return count;
+}
+
+bool
+TileBitSet::Any() const
+{
+	for (auto word : mWords)
+	{
+		if (word != 0)
+			return true;
+	}
+
+	return false;
+}
+
+bool
+TileBitSet::None() const
+{
+	return !Any();
+}
+
+TileBitSet&
+TileBitSet::operator|=(const TileBitSet& rhs)
+{
+	assert(mNumTiles == rhs.mNumTiles);
+	for (size_t i = 0; i < mWords.size(); ++i)
+		mWords[i] |= rhs.mWords[i];
+
+	return *this;
+}
+
+TileBitSet&
+TileBitSet::operator&=(const TileBitSet& rhs)
+{
+	assert(mNumTiles == rhs.mNumTiles);
+	for (size_t i = 0; i < mWords.size(); ++i)
+		mWords[i] &= rhs.mWords[i];
+
+	return *this;
+}
+
+TileBitSet&
+TileBitSet::operator-=(const TileBitSet& rhs)
+{
+	assert(mNumTiles == rhs.mNumTiles);
+	for (size_t i = 0; i < mWords.size(); ++i)
+		mWords[i] &= ~rhs.mWords[i];
+
+	return *this;
+}
+
+bool
+TileBitSet::operator==(const TileBitSet& rhs) const
+{
+	return mNumTiles == rhs.mNumTiles && mWords == rhs.mWords;
+}
+
+bool
+TileBitSet::operator!=(const TileBitSet& rhs) const
+{
+	return !(*this == rhs);
+}
+
+TileBitSet::Word
+TileBitSet::ExtractWord(int bitPos) const
+{
+	//read the 64 bits starting at bitPos, bits past the end of the set read as zero
+	const int wordIndex = bitPos / BITS_PER_WORD;
+	const int bitOffset = bitPos % BITS_PER_WORD;
+
+	Word result = mWords[wordIndex] >> bitOffset;
+	if (bitOffset != 0 && wordIndex + 1 < GetNumWords())
+		result |= mWords[wordIndex + 1] << (BITS_PER_WORD - bitOffset);
+
+	return result;
+}
+
+void
+TileBitSet::OrShiftedRange(const TileBitSet& src, int start, int length, int delta)
+{
+	assert(start >= 0 && start + length <= src.mNumTiles);
+	assert(start + delta >= 0 && start + delta + length <= mNumTiles);
+	if (length <= 0)
+		return;
+
+	//walk the destination a word at a time, pulling the matching bits out of the source
+	const int dstBegin = start + delta;
+	const int dstEnd = dstBegin + length;
+	for (int wordIndex = dstBegin / BITS_PER_WORD; wordIndex * BITS_PER_WORD < dstEnd; ++wordIndex)
+	{
+		const int wordBegin = wordIndex * BITS_PER_WORD;
+		const int lo = std::max(dstBegin, wordBegin);
+		const int hi = std::min(dstEnd, wordBegin + BITS_PER_WORD);
+
+		const auto bits = src.ExtractWord(lo - delta) & GetLowBitMask(hi - lo);
+		mWords[wordIndex] |= bits << (lo - wordBegin);
+	}
+}
+
+TileIDSet
+TileBitSet::ToTileIDSet() const
+{
+	TileIDSet tiles;
+	ForEach([&tiles](int tileID) { tiles.insert(tileID); });
+	return tiles;
+}
+
+void
+TileBitSet::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mNumTiles);
+	writer.WriteVector(mWords);
+}
+
+void
+TileBitSet::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mNumTiles);
+	reader.ReadVector(mWords);
+}
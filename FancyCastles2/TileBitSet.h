@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+class SnapshotReader;
+class SnapshotWriter;
+
+using TileIDSet = std::unordered_set < int >;
+
+//A set of tile IDs stored as one bit per tile on the board. Set operations
+// work a 64 bit word at a time, so a 61 tile board fits in a single word
+class TileBitSet
+{
+public:
+	using Word = std::uint64_t;
+	static const int BITS_PER_WORD = 64;
+
+	TileBitSet();
+	explicit TileBitSet(int numTiles);
+	TileBitSet(int numTiles, const TileIDSet& tiles);
+
+	int GetNumTiles() const;
+	int GetNumWords() const;
+	Word GetWord(int wordIndex) const;
+
+	void Set(int tileID);
+	void Reset(int tileID);
+	bool Test(int tileID) const;
+	void Clear();
+
+	int Count() const;
+	bool Any() const;
+	bool None() const;
+
+	TileBitSet& operator|=(const TileBitSet& rhs);
+	TileBitSet& operator&=(const TileBitSet& rhs);
+	TileBitSet& operator-=(const TileBitSet& rhs);
+	bool operator==(const TileBitSet& rhs) const;
+	bool operator!=(const TileBitSet& rhs) const;
+
+	//for every tile i in [start, start + length) that is in src, add tile i + delta to this set
+	void OrShiftedRange(const TileBitSet& src, int start, int length, int delta);
+
+	TileIDSet ToTileIDSet() const;
+
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
+	template <typename Func>
+	void ForEach(Func func) const
+	{
+		for (int wordIndex = 0; wordIndex < GetNumWords(); ++wordIndex)
+		{
+			auto word = mWords[wordIndex];
+			while (word != 0)
+			{
+				func(wordIndex * BITS_PER_WORD + CountTrailingZeros(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+	static int PopCount(Word word);
+	static int CountTrailingZeros(Word word);
+
+private:
+	Word ExtractWord(int bitPos) const;
+
+	int mNumTiles;
+	std::vector<Word> mWords;
+};
+
+inline TileBitSet operator|(TileBitSet lhs, const TileBitSet& rhs) { return lhs |= rhs; }
+inline TileBitSet operator&(TileBitSet lhs, const TileBitSet& rhs) { return lhs &= rhs; }
+inline TileBitSet operator-(TileBitSet lhs, const TileBitSet& rhs) { return lhs -= rhs; }
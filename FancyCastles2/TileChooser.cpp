@@ -19,7 +19,7 @@ TileChooser::ChooseTiles()
 {
 	while (mNumTilesToChoose >=0)
 	{
-		mRenderer.RenderScene();
+		mRenderer.RunFrame(FramePacer::NoDeadline());
 	}
 }
 
@@ -54,6 +54,20 @@ TileChooser::OnNotify(Command* cmd)
 		return;
 	}
 
+	auto panCmd = dynamic_cast<PanCameraCommand*>(cmd);
+	if (panCmd)
+	{
+		mRenderer.PanCamera(panCmd->GetDX(), panCmd->GetDY());
+		return;
+	}
+
+	auto zoomCmd = dynamic_cast<ZoomCameraCommand*>(cmd);
+	if (zoomCmd)
+	{
+		mRenderer.ZoomCamera(zoomCmd->GetFactor());
+		return;
+	}
+
 	auto changePlayerCmd = dynamic_cast<ChangePlayerCommand*>(cmd);
 	if (changePlayerCmd)
 	{
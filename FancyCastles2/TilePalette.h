@@ -0,0 +1,37 @@
+#pragma once
+
+#include "TileTraits.h"
+
+//the color each resource type is drawn in, shared by every renderer
+namespace TilePalette
+{
+	inline Color
+	GetColor(const ResourceType& tileType)
+	{
+		//placeholder method to verify
+		Color tileColor;
+		switch (tileType)
+		{
+		case ResourceType::WATER:
+			tileColor.b = 1.f;
+			break;
+		case ResourceType::GRASS:
+			tileColor.g = 1.f;
+			break;
+		case ResourceType::WHEAT:
+			tileColor.r = tileColor.g = 1.f;
+			break;
+		case ResourceType::TREE:
+			tileColor.r = 0.6f;
+			tileColor.g = 0.29f;
+			break;
+		case ResourceType::ORE:
+			tileColor.r = tileColor.g = tileColor.b = 0.47f;
+			break;
+		default:
+			break;
+		}
+
+		return tileColor;
+	}
+}
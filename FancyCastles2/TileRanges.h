@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+
+#include "HexMath.h"
+#include "TileTraits.h"
+
+//Read only view of the board's dense coord -> tile ID index. It only holds
+// the board radius and two table pointers, so iterators carry a copy and
+// turn coordinates into tile IDs without going back through the board
+struct TileIndexView
+{
+	int mMapRadius;
+	const int* mColumnOffsets;
+	const int* mColumnSlotToTile;	//null when tiles are numbered column by column
+
+	TileIndexView() : mMapRadius(-1), mColumnOffsets(nullptr), mColumnSlotToTile(nullptr) { }
+	TileIndexView(int mapRadius, const int* columnOffsets, const int* columnSlotToTile)
+		: mMapRadius(mapRadius), mColumnOffsets(columnOffsets), mColumnSlotToTile(columnSlotToTile) { }
+
+	bool IsPositionValid(const AxialCoord& position) const
+	{
+		return HexMath::IsInsideRadius(position, mMapRadius);
+	}
+
+	//first and last r of a column of the board
+	int GetColumnBegin(int q) const
+	{
+		return std::max(-mMapRadius, -q - mMapRadius);
+	}
+
+	int GetColumnEnd(int q) const
+	{
+		return std::min(mMapRadius, -q + mMapRadius);
+	}
+
+	int GetColumnSlot(const AxialCoord& coord) const
+	{
+		return mColumnOffsets[coord.q + mMapRadius] + (coord.r - GetColumnBegin(coord.q));
+	}
+
+	int GetTileIndex(const AxialCoord& coord) const
+	{
+		const auto columnSlot = GetColumnSlot(coord);
+		return mColumnSlotToTile ? mColumnSlotToTile[columnSlot] : columnSlot;
+	}
+};
+
+//every tile at most mRadius steps from mCenter, column by column in q.
+//Each column is clipped to the board up front so no position is ever rejected
+class TileAreaRange
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = int;
+		using difference_type = int;
+		using pointer = const int*;
+		using reference = int;
+
+		Iterator() : mRange(nullptr), mR(0), mQ(0), mREnd(-1) { }
+		Iterator(const TileAreaRange* range, int q) : mRange(range), mR(0), mQ(q), mREnd(-1)
+		{
+			SkipEmptyColumns();
+		}
+
+		int operator*() const { return mRange->mIndex.GetTileIndex(AxialCoord(mR, mQ)); }
+		AxialCoord GetCoord() const { return AxialCoord(mR, mQ); }
+
+		Iterator& operator++()
+		{
+			if (++mR > mREnd)
+			{
+				++mQ;
+				SkipEmptyColumns();
+			}
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto prev = *this;
+			++*this;
+			return prev;
+		}
+
+		bool operator==(const Iterator& other) const { return mQ == other.mQ && mR == other.mR; }
+		bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+	private:
+		//move to the first column at or after mQ that has tiles in range
+		void SkipEmptyColumns()
+		{
+			for (; mQ <= mRange->mQEnd; ++mQ)
+			{
+				const int dq = mQ - mRange->mCenter.q;
+				mR = std::max(mRange->mIndex.GetColumnBegin(mQ), mRange->mCenter.r + std::max(-mRange->mRadius, -dq - mRange->mRadius));
+				mREnd = std::min(mRange->mIndex.GetColumnEnd(mQ), mRange->mCenter.r + std::min(mRange->mRadius, -dq + mRange->mRadius));
+				if (mR <= mREnd)
+					return;
+			}
+			mQ = mRange->mQEnd + 1;
+			mR = 0;
+		}
+
+		const TileAreaRange* mRange;
+		int mR, mQ;
+		int mREnd;
+	};
+
+	TileAreaRange() : mRadius(-1), mQBegin(0), mQEnd(-1) { }
+	TileAreaRange(const TileIndexView& index, const AxialCoord& center, int radius)
+		: mIndex(index), mCenter(center), mRadius(radius)
+		, mQBegin(std::max(-index.mMapRadius, center.q - radius))
+		, mQEnd(std::min(index.mMapRadius, center.q + radius))
+	{
+	}
+
+	Iterator begin() const { return Iterator(this, mQBegin); }
+	Iterator end() const { return Iterator(this, mQEnd + 1); }
+	bool empty() const { return begin() == end(); }
+
+private:
+	TileIndexView mIndex;
+	AxialCoord mCenter;
+	int mRadius;
+	int mQBegin, mQEnd;
+};
+
+//every tile exactly mRadius steps from mCenter, in HexMath::RingCoord order.
+//Positions off the board are stepped over
+class TileRingRange
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = int;
+		using difference_type = int;
+		using pointer = const int*;
+		using reference = int;
+
+		Iterator() : mRange(nullptr), mRingIndex(0) { }
+		Iterator(const TileRingRange* range, int ringIndex) : mRange(range), mRingIndex(ringIndex)
+		{
+			if (mRingIndex < mRange->mRingSize)
+			{
+				mPosition = HexMath::RingCoord(mRange->mCenter, mRange->mRadius, mRingIndex);
+				SkipInvalid();
+			}
+		}
+
+		int operator*() const { return mRange->mIndex.GetTileIndex(mPosition); }
+		AxialCoord GetCoord() const { return mPosition; }
+
+		Iterator& operator++()
+		{
+			Step();
+			SkipInvalid();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto prev = *this;
+			++*this;
+			return prev;
+		}
+
+		bool operator==(const Iterator& other) const { return mRingIndex == other.mRingIndex; }
+		bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+	private:
+		//the step out of the i-th hex of a ring is along side i / radius
+		void Step()
+		{
+			if (++mRingIndex < mRange->mRingSize)
+				mPosition += HexMath::Direction((mRingIndex - 1) / mRange->mRadius);
+		}
+
+		void SkipInvalid()
+		{
+			while (mRingIndex < mRange->mRingSize && !mRange->mIndex.IsPositionValid(mPosition))
+				Step();
+		}
+
+		const TileRingRange* mRange;
+		int mRingIndex;
+		AxialCoord mPosition;
+	};
+
+	TileRingRange() : mRadius(0), mRingSize(0) { }
+	TileRingRange(const TileIndexView& index, const AxialCoord& center, int radius)
+		: mIndex(index), mCenter(center), mRadius(radius)
+		, mRingSize(radius < 0 ? 0 : HexMath::RingSize(radius))
+	{
+	}
+
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, mRingSize); }
+	bool empty() const { return begin() == end(); }
+
+private:
+	TileIndexView mIndex;
+	AxialCoord mCenter;
+	int mRadius;
+	int mRingSize;
+};
+
+//every tile on the hex line from mFrom to mTo, both ends included, in order
+// from mFrom. Positions off the board are stepped over
+class TileLineRange
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = int;
+		using difference_type = int;
+		using pointer = const int*;
+		using reference = int;
+
+		Iterator() : mRange(nullptr), mLineIndex(0) { }
+		Iterator(const TileLineRange* range, int lineIndex) : mRange(range), mLineIndex(lineIndex)
+		{
+			SkipInvalid();
+		}
+
+		int operator*() const { return mRange->mIndex.GetTileIndex(mPosition); }
+		AxialCoord GetCoord() const { return mPosition; }
+
+		//true for the first and last tile of the line
+		bool IsEndpoint() const { return mLineIndex == 0 || mLineIndex == mRange->mLineSize - 1; }
+
+		Iterator& operator++()
+		{
+			++mLineIndex;
+			SkipInvalid();
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto prev = *this;
+			++*this;
+			return prev;
+		}
+
+		bool operator==(const Iterator& other) const { return mLineIndex == other.mLineIndex; }
+		bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+	private:
+		void SkipInvalid()
+		{
+			for (; mLineIndex < mRange->mLineSize; ++mLineIndex)
+			{
+				mPosition = HexMath::LineCoord(mRange->mFrom, mRange->mTo, mLineIndex);
+				if (mRange->mIndex.IsPositionValid(mPosition))
+					return;
+			}
+		}
+
+		const TileLineRange* mRange;
+		int mLineIndex;
+		AxialCoord mPosition;
+	};
+
+	TileLineRange() : mLineSize(0) { }
+	TileLineRange(const TileIndexView& index, const AxialCoord& from, const AxialCoord& to)
+		: mIndex(index), mFrom(from), mTo(to), mLineSize(HexMath::LineSize(from, to))
+	{
+	}
+
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, mLineSize); }
+	bool empty() const { return begin() == end(); }
+
+private:
+	TileIndexView mIndex;
+	AxialCoord mFrom, mTo;
+	int mLineSize;
+};
@@ -1,18 +1,24 @@
 #pragma once
 
+#include <array>
 #include <memory>
 
 struct AxialCoord
 {
 	int r, q;
-	AxialCoord() : r(0), q(0) { }
-	AxialCoord(int r_in, int q_in) :r(r_in), q(q_in) { }
+	constexpr AxialCoord() : r(0), q(0) { }
+	constexpr AxialCoord(int r_in, int q_in) :r(r_in), q(q_in) { }
 
-	bool operator==(const AxialCoord& other) const
+	constexpr bool operator==(const AxialCoord& other) const
 	{
 		return (other.r == r && other.q == q);
 	}
 
+	constexpr bool operator!=(const AxialCoord& other) const
+	{
+		return !(*this == other);
+	}
+
 	AxialCoord& operator+=(const AxialCoord& rhs) // compound assignment (does not need to be a member,
 	{											  // but often is, to modify the private members)
 		r += rhs.r;
@@ -20,11 +26,21 @@ struct AxialCoord
 		return *this; // return the result by reference
 	}
 
-	// friends defined inside class body are inline and are hidden from non-ADL lookup
-	friend AxialCoord operator+(      AxialCoord  lhs,       // passing first arg by value helps optimize chained a+b+c
-							    const AxialCoord& rhs)		 // alternatively, both parameters may be const references.
+	// friends defined inside class body are inline and are hidden from non-ADL lookup.
+	// built directly instead of through += so it stays usable in constant expressions
+	friend constexpr AxialCoord operator+(const AxialCoord& lhs, const AxialCoord& rhs)
+	{
+		return AxialCoord(lhs.r + rhs.r, lhs.q + rhs.q);
+	}
+
+	friend constexpr AxialCoord operator-(const AxialCoord& lhs, const AxialCoord& rhs)
 	{
-		return lhs += rhs; // reuse compound assignment and return the result by value
+		return AxialCoord(lhs.r - rhs.r, lhs.q - rhs.q);
+	}
+
+	friend constexpr AxialCoord operator*(const AxialCoord& lhs, int scale)
+	{
+		return AxialCoord(lhs.r * scale, lhs.q * scale);
 	}
 };
 
@@ -33,14 +49,30 @@ namespace std {
 	{
 		size_t operator()(const AxialCoord& h) const
 		{
-			hash<int> int_hash;
-			size_t hq = int_hash(h.q);
-			size_t hr = int_hash(h.r);
-			return hq ^ (hr + 0x9e3779b9 + (hq << 6) + (hq >> 2));
+			//pack both coordinates into one 64 bit key and run it through the splitmix64 finalizer
+			unsigned long long key = (static_cast<unsigned long long>(static_cast<unsigned int>(h.r)) << 32) | static_cast<unsigned int>(h.q);
+			key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+			key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+			return static_cast<size_t>(key ^ (key >> 31));
 		}
 	};
 }
 
+//non-owning view over a contiguous run of tile IDs, valid as long as the owner isn't modified
+struct TileIDRange
+{
+	const int* mBegin;
+	const int* mEnd;
+
+	TileIDRange() : mBegin(nullptr), mEnd(nullptr) { }
+	TileIDRange(const int* begin_in, const int* end_in) : mBegin(begin_in), mEnd(end_in) { }
+
+	const int* begin() const { return mBegin; }
+	const int* end() const { return mEnd; }
+	int size() const { return static_cast<int>(mEnd - mBegin); }
+	bool empty() const { return mBegin == mEnd; }
+};
+
 struct Color
 {
 	float r, g, b;
@@ -60,6 +92,18 @@ enum class ResourceType
 	INVALID
 };
 
+//set of resource types, one bit per ResourceType value
+using ResourceTypeMask = unsigned int;
+
+inline ResourceTypeMask
+ToResourceTypeMask(ResourceType type)
+{
+	return 1u << static_cast<unsigned int>(type);
+}
+
+//one running total per resource type, indexed by the ResourceType value
+using ResourceTotals = std::array < int, static_cast<size_t>(ResourceType::NUMTYPES) > ;
+
 enum class BuildingType
 {
 	FORGE,
@@ -1,7 +1,9 @@
 #include "Timer.h"
 
+#include "GameSnapshot.h"
+
 TimerObject::TimerObject(int timerID)
-	: GameObject(timerID, -1), mTimerID(timerID), mTimerState(), mTimeoutSec(3.0)
+	: GameObject(timerID, -1), mTimerID(timerID), mTimerState(), mTimeout(std::chrono::seconds(3))
 {
 }
 
@@ -12,10 +14,10 @@ TimerObject::GetObjectType() const
 }
 
 void
-TimerObject::OnTimerStart(TimerResultPtr result)
+TimerObject::OnTimerStart(TimerResultPtr result, std::chrono::steady_clock::time_point now)
 {
 	mTimerState.mIsBusy = true;
-	mTimerState.mStartTime = std::clock();
+	mTimerState.mDeadline = now + mTimeout;
 	mTimerState.mResult = result;
 }
 
@@ -26,25 +28,18 @@ TimerObject::OnTimerFinished()
 	Notify(mTimerState.mResult);
 }
 
-void
-TimerObject::Tick()
-{
-	if (mTimerState.mIsBusy)
-	{
-		const auto duration = (std::clock() - mTimerState.mStartTime) / (double(CLOCKS_PER_SEC));
-		if (duration - mTimeoutSec > DBL_EPSILON)
-		{
-			OnTimerFinished();
-		}
-	}
-}
-
 bool
 TimerObject::IsBusy() const
 {
 	return mTimerState.mIsBusy; 
 }
 
+std::chrono::steady_clock::time_point
+TimerObject::GetDeadline() const
+{
+	return mTimerState.mDeadline;
+}
+
 int
 TimerObject::GetObjectID() const
 {
@@ -55,4 +50,37 @@ void
 TimerObject::Cancel()
 {
 	mTimerState.mIsBusy = false;
-}
\ No newline at end of file
+}
+
+void
+TimerObject::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mPosition);
+	writer.Write(mTimerState.mIsBusy);
+	writer.Write(mTimerState.mDeadline.time_since_epoch().count());
+
+	const bool hasResult = mTimerState.mResult != nullptr;
+	writer.Write(hasResult);
+	if (hasResult)
+		writer.Write(*mTimerState.mResult);
+}
+
+void
+TimerObject::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mPosition);
+	reader.Read(mTimerState.mIsBusy);
+
+	std::chrono::steady_clock::rep deadline;
+	reader.Read(deadline);
+	mTimerState.mDeadline = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(deadline));
+
+	bool hasResult;
+	reader.Read(hasResult);
+	mTimerState.mResult = nullptr;
+	if (hasResult)
+	{
+		mTimerState.mResult = std::make_shared<TimerResult>();
+		reader.Read(*mTimerState.mResult);
+	}
+}
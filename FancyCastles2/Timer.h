@@ -1,9 +1,12 @@
 #pragma once
 
-#include <ctime>
+#include <chrono>
 
 #include "GameObject.h"
 
+class SnapshotReader;
+class SnapshotWriter;
+
 struct TimerResult
 {
 	TimerResult()
@@ -26,28 +29,36 @@ public:
 
 	TimerObject(int timerID);
 
-	void OnTimerStart(TimerResultPtr result);
+	//the timer runs for its timeout from now
+	void OnTimerStart(TimerResultPtr result, std::chrono::steady_clock::time_point now);
 	void OnTimerFinished();
 
-	void Tick();
 	void Cancel();
 
 	bool IsBusy() const;
 
+	//when a busy timer will finish. Whoever started it keeps the deadline in a
+	// TimerWheel and calls OnTimerFinished once it passes
+	std::chrono::steady_clock::time_point GetDeadline() const;
+
 	int GetObjectID() const override;
 	GameObjectType GetObjectType() const override;
 
+	//where it is, whether it's running and what it gives when it finishes
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
 private:
 	struct TimerState
 	{
 		bool mIsBusy;
-		time_t mStartTime;
+		std::chrono::steady_clock::time_point mDeadline;
 		TimerResultPtr mResult;
 
-		TimerState() : mIsBusy(false), mStartTime(std::clock()) { }
+		TimerState() : mIsBusy(false) { }
 	};
 
-	const double mTimeoutSec;
+	const std::chrono::steady_clock::duration mTimeout;
 	TimerState mTimerState;
 
 	int mTimerID;
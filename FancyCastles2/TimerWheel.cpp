@@ -0,0 +1,388 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "GameSnapshot.h"
+#include "TileBitSet.h"
+
+const int TimerWheel::NUM_LEVELS;
+const int TimerWheel::SLOT_BITS;
+const int TimerWheel::NUM_SLOTS;
+
+namespace
+{
+	const int SLOT_MASK = TimerWheel::NUM_SLOTS - 1;
+	const int DUE_BUCKET = TimerWheel::NUM_LEVELS * TimerWheel::NUM_SLOTS;
+	const int OVERFLOW_BUCKET = DUE_BUCKET + 1;
+	const int TOP_LEVEL = TimerWheel::NUM_LEVELS - 1;
+	static_assert(TimerWheel::NUM_SLOTS == 64, "a level's occupied slots are one 64 bit word");
+
+	int
+	GetLevelShift(int level)
+	{
+		return TimerWheel::SLOT_BITS * level;
+	}
+
+	//bits of word moved down by count, the low ones coming back in at the top
+	std::uint64_t
+	RotateRight(std::uint64_t word, int count)
+	{
+		count &= 63;
+		return count == 0 ? word : (word >> count) | (word << (64 - count));
+	}
+}
+
+TimerWheel::TimerWheel(Clock::time_point start, Clock::duration tickLength)
+	: mStart(start)
+	, mTickLength(tickLength)
+	, mCurrentTick(0)
+	, mBucketHeads(OVERFLOW_BUCKET + 1, -1)
+	, mNumScheduled(0)
+{
+	assert(tickLength > Clock::duration::zero());
+	std::fill(mOccupied, mOccupied + NUM_LEVELS, 0);
+}
+
+void
+TimerWheel::Schedule(int timerID, Clock::time_point deadline)
+{
+	int node;
+	const auto found = mNodeOfTimer.find(timerID);
+	if (found != mNodeOfTimer.end())
+	{
+		node = found->second;
+		Unlink(node);
+	}
+	else
+	{
+		if (mFreeNodes.empty())
+		{
+			mFreeNodes.push_back(static_cast<int>(mNodes.size()));
+			mNodes.emplace_back();
+		}
+		node = mFreeNodes.back();
+		mFreeNodes.pop_back();
+		mNodeOfTimer[timerID] = node;
+		mNumScheduled++;
+	}
+
+	mNodes[node].mTimerID = timerID;
+	mNodes[node].mDeadline = ToTick(deadline, true);
+	Insert(node);
+}
+
+bool
+TimerWheel::Cancel(int timerID)
+{
+	const auto found = mNodeOfTimer.find(timerID);
+	if (found == mNodeOfTimer.end())
+		return false;
+
+	Unlink(found->second);
+	FreeNode(found->second);
+	return true;
+}
+
+bool
+TimerWheel::IsScheduled(int timerID) const
+{
+	return mNodeOfTimer.count(timerID) > 0;
+}
+
+int
+TimerWheel::GetNumScheduled() const
+{
+	return mNumScheduled;
+}
+
+void
+TimerWheel::Advance(Clock::time_point now, std::vector<int>& expiredTimers)
+{
+	const auto target = ToTick(now, false);
+	Expire(DUE_BUCKET, expiredTimers);
+
+	while (mCurrentTick < target)
+	{
+		//jump straight over ticks with nothing to fire or spread out
+		const auto next = mNumScheduled > 0 ? GetNextEventTick() : target + 1;
+		if (next > target)
+		{
+			mCurrentTick = target;
+			break;
+		}
+		mCurrentTick = next;
+
+		//a tick that starts a level's bucket spreads it over the levels below,
+		// anything due right now lands in the due bucket
+		for (int level = 1; level < NUM_LEVELS; ++level)
+		{
+			if ((mCurrentTick & ((Tick(1) << GetLevelShift(level)) - 1)) != 0)
+				break;
+			Cascade(level);
+		}
+		if ((mCurrentTick & ((Tick(1) << GetLevelShift(TOP_LEVEL)) - 1)) == 0)
+			CascadeOverflow();
+
+		Expire(static_cast<int>(mCurrentTick & SLOT_MASK), expiredTimers);
+		Expire(DUE_BUCKET, expiredTimers);
+	}
+}
+
+TimerWheel::Clock::time_point
+TimerWheel::GetNextDeadline() const
+{
+	if (mNumScheduled == 0)
+		return Clock::time_point::max();
+
+	auto nextDeadline = std::numeric_limits<Tick>::max();
+	for (auto bucket : { DUE_BUCKET, OVERFLOW_BUCKET })
+	{
+		for (int node = mBucketHeads[bucket]; node >= 0; node = mNodes[node].mNext)
+			nextDeadline = std::min(nextDeadline, mNodes[node].mDeadline);
+	}
+
+	//the first bucket after the current one at each level holds that level's
+	// soonest timers. A lower level isn't always sooner, its buckets that have
+	// wrapped around come after the next bucket of the level above
+	for (int level = 0; level < NUM_LEVELS; ++level)
+	{
+		if (mOccupied[level] == 0)
+			continue;
+
+		const int position = static_cast<int>((mCurrentTick >> GetLevelShift(level)) & SLOT_MASK);
+		const int offset = TileBitSet::CountTrailingZeros(RotateRight(mOccupied[level], position + 1));
+		const int slot = (position + 1 + offset) & SLOT_MASK;
+		for (int node = mBucketHeads[level * NUM_SLOTS + slot]; node >= 0; node = mNodes[node].mNext)
+			nextDeadline = std::min(nextDeadline, mNodes[node].mDeadline);
+	}
+
+	return ToTime(nextDeadline);
+}
+
+TimerWheel::Clock::duration
+TimerWheel::GetTickLength() const
+{
+	return mTickLength;
+}
+
+TimerWheel::Tick
+TimerWheel::ToTick(Clock::time_point time, bool roundUp) const
+{
+	if (time <= mStart)
+		return 0;
+
+	const auto sinceStart = time - mStart;
+	Tick ticks = static_cast<Tick>(sinceStart / mTickLength);
+	if (roundUp && sinceStart % mTickLength != Clock::duration::zero())
+		ticks++;
+	return ticks;
+}
+
+TimerWheel::Clock::time_point
+TimerWheel::ToTime(Tick tick) const
+{
+	//a deadline of time_point::max() rounds up to a tick past it
+	if (tick > static_cast<Tick>((Clock::time_point::max() - mStart) / mTickLength))
+		return Clock::time_point::max();
+	return mStart + mTickLength * static_cast<Clock::rep>(tick);
+}
+
+void
+TimerWheel::Insert(int node)
+{
+	const auto deadline = mNodes[node].mDeadline;
+	if (deadline <= mCurrentTick)
+	{
+		Link(node, DUE_BUCKET);
+		return;
+	}
+
+	//the lowest level whose span reaches the deadline
+	const auto ticksLeft = deadline - mCurrentTick;
+	for (int level = 0; level < NUM_LEVELS; ++level)
+	{
+		if (ticksLeft < (Tick(1) << GetLevelShift(level + 1)))
+		{
+			Link(node, level * NUM_SLOTS + static_cast<int>((deadline >> GetLevelShift(level)) & SLOT_MASK));
+			return;
+		}
+	}
+
+	//past the top level, it's looked at again each time the top level moves on
+	Link(node, OVERFLOW_BUCKET);
+}
+
+void
+TimerWheel::Link(int node, int bucket)
+{
+	auto& timerNode = mNodes[node];
+	timerNode.mBucket = bucket;
+	timerNode.mPrev = -1;
+	timerNode.mNext = mBucketHeads[bucket];
+	if (timerNode.mNext >= 0)
+		mNodes[timerNode.mNext].mPrev = node;
+	mBucketHeads[bucket] = node;
+
+	if (bucket < DUE_BUCKET)
+		mOccupied[bucket / NUM_SLOTS] |= std::uint64_t(1) << (bucket % NUM_SLOTS);
+}
+
+void
+TimerWheel::Unlink(int node)
+{
+	const auto& timerNode = mNodes[node];
+	if (timerNode.mPrev >= 0)
+		mNodes[timerNode.mPrev].mNext = timerNode.mNext;
+	else
+		mBucketHeads[timerNode.mBucket] = timerNode.mNext;
+	if (timerNode.mNext >= 0)
+		mNodes[timerNode.mNext].mPrev = timerNode.mPrev;
+
+	if (timerNode.mBucket < DUE_BUCKET && mBucketHeads[timerNode.mBucket] < 0)
+		mOccupied[timerNode.mBucket / NUM_SLOTS] &= ~(std::uint64_t(1) << (timerNode.mBucket % NUM_SLOTS));
+}
+
+void
+TimerWheel::FreeNode(int node)
+{
+	mNodeOfTimer.erase(mNodes[node].mTimerID);
+	mFreeNodes.push_back(node);
+	mNumScheduled--;
+}
+
+TimerWheel::Tick
+TimerWheel::GetNextEventTick() const
+{
+	//timers past the top level need a look each time it moves on
+	auto nextEvent = std::numeric_limits<Tick>::max();
+	if (mBucketHeads[OVERFLOW_BUCKET] >= 0)
+		nextEvent = ((mCurrentTick >> GetLevelShift(TOP_LEVEL)) + 1) << GetLevelShift(TOP_LEVEL);
+
+	//otherwise the lowest level with anything in it decides. Buckets after the
+	// current one in this turn of the level come first, if it only has buckets
+	// that have wrapped around the next thing to do is where the level above moves on
+	for (int level = 0; level < NUM_LEVELS; ++level)
+	{
+		if (mOccupied[level] == 0)
+			continue;
+
+		const auto shift = GetLevelShift(level);
+		const auto levelTick = mCurrentTick >> shift;
+		const int position = static_cast<int>(levelTick & SLOT_MASK);
+		const auto later = position == SLOT_MASK ? 0 : mOccupied[level] & (~std::uint64_t(0) << (position + 1));
+		if (later != 0)
+			return std::min(nextEvent, (levelTick - position + TileBitSet::CountTrailingZeros(later)) << shift);
+
+		return std::min(nextEvent, ((levelTick | SLOT_MASK) + 1) << shift);
+	}
+
+	return nextEvent;
+}
+
+void
+TimerWheel::Cascade(int level)
+{
+	const int bucket = level * NUM_SLOTS + static_cast<int>((mCurrentTick >> GetLevelShift(level)) & SLOT_MASK);
+	int node = mBucketHeads[bucket];
+	mBucketHeads[bucket] = -1;
+	mOccupied[level] &= ~(std::uint64_t(1) << (bucket % NUM_SLOTS));
+
+	while (node >= 0)
+	{
+		const int next = mNodes[node].mNext;
+		Insert(node);
+		node = next;
+	}
+}
+
+void
+TimerWheel::CascadeOverflow()
+{
+	int node = mBucketHeads[OVERFLOW_BUCKET];
+	mBucketHeads[OVERFLOW_BUCKET] = -1;
+
+	while (node >= 0)
+	{
+		const int next = mNodes[node].mNext;
+		Insert(node);
+		node = next;
+	}
+}
+
+void
+TimerWheel::Expire(int bucket, std::vector<int>& expiredTimers)
+{
+	int node = mBucketHeads[bucket];
+	if (node < 0)
+		return;
+
+	mBucketHeads[bucket] = -1;
+	if (bucket < DUE_BUCKET)
+		mOccupied[bucket / NUM_SLOTS] &= ~(std::uint64_t(1) << (bucket % NUM_SLOTS));
+
+	const auto firstExpired = expiredTimers.size();
+	while (node >= 0)
+	{
+		const int next = mNodes[node].mNext;
+		expiredTimers.push_back(node);
+		node = next;
+	}
+
+	//a level 0 bucket's timers all have the same deadline, the due bucket's can differ
+	if (bucket == DUE_BUCKET)
+	{
+		std::stable_sort(expiredTimers.begin() + firstExpired, expiredTimers.end(),
+			[this](int a, int b) { return mNodes[a].mDeadline < mNodes[b].mDeadline; });
+	}
+
+	//nodes were collected above, swap them for their timer IDs
+	for (auto expired = expiredTimers.begin() + firstExpired; expired != expiredTimers.end(); ++expired)
+	{
+		const int expiredNode = *expired;
+		*expired = mNodes[expiredNode].mTimerID;
+		FreeNode(expiredNode);
+	}
+}
+
+void
+TimerWheel::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mStart);
+	writer.Write(mTickLength);
+	writer.Write(mCurrentTick);
+	writer.Write(mNumScheduled);
+	writer.WriteArray(mOccupied, NUM_LEVELS);
+	writer.WriteVector(mNodes);
+	writer.WriteVector(mFreeNodes);
+	writer.WriteVector(mBucketHeads);
+}
+
+void
+TimerWheel::LoadState(SnapshotReader& reader)
+{
+	//the saved ticks only mean the right times against the wheel they came from
+	reader.Read(mStart);
+	reader.Read(mTickLength);
+	assert(mTickLength > Clock::duration::zero());
+	reader.Read(mCurrentTick);
+	reader.Read(mNumScheduled);
+	reader.ReadArray(mOccupied, NUM_LEVELS);
+	reader.ReadVector(mNodes);
+	reader.ReadVector(mFreeNodes);
+	reader.ReadVector(mBucketHeads);
+
+	//every node that isn't free holds a timer
+	std::vector<bool> isFree(mNodes.size(), false);
+	for (auto node : mFreeNodes)
+		isFree[node] = true;
+
+	mNodeOfTimer.clear();
+	for (int node = 0; node < static_cast<int>(mNodes.size()); ++node)
+	{
+		if (!isFree[node])
+			mNodeOfTimer[mNodes[node].mTimerID] = node;
+	}
+	assert(static_cast<int>(mNodeOfTimer.size()) == mNumScheduled);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class SnapshotReader;
+class SnapshotWriter;
+
+//Hierarchical timing wheel: keeps every running timer's deadline and hands back
+// the ones that have passed, touching only the buckets that came due.
+//Time is counted in ticks from the wheel's start. Level 0 has a bucket per tick
+// for the next NUM_SLOTS ticks, each level above covers NUM_SLOTS times the span
+// of the one below. A level's bucket is spread over the level below when time
+// reaches it, so timers work their way down to level 0 and fire from there.
+//Timers further off than the top level reaches wait in an overflow list.
+//Deadlines are rounded up to a whole tick, a timer never fires early and at
+// most one tick late
+class TimerWheel
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit TimerWheel(Clock::time_point start, Clock::duration tickLength = std::chrono::milliseconds(1));
+
+	//(re)starts the timer with this ID
+	void Schedule(int timerID, Clock::time_point deadline);
+	//false if the timer wasn't running
+	bool Cancel(int timerID);
+	bool IsScheduled(int timerID) const;
+	int GetNumScheduled() const;
+
+	//moves the wheel up to now and appends the IDs of the timers that came due,
+	// soonest deadline first. They're no longer scheduled when this returns
+	void Advance(Clock::time_point now, std::vector<int>& expiredTimers);
+
+	//when Advance would next return a timer, time_point::max() if none are running
+	Clock::time_point GetNextDeadline() const;
+
+	Clock::duration GetTickLength() const;
+
+	//the buckets and nodes are copied as they are, restoring only has to work out
+	// which node each timer is in again. The start and tick length come along,
+	// so a wheel made at another time takes on the saved one's
+	void SaveState(SnapshotWriter& writer) const;
+	void LoadState(SnapshotReader& reader);
+
+	static const int NUM_LEVELS = 4;
+	static const int SLOT_BITS = 6;
+	static const int NUM_SLOTS = 1 << SLOT_BITS;
+
+private:
+	using Tick = std::uint64_t;
+
+	//timers are nodes in a doubly linked list per bucket, so any one can be
+	// taken out without searching
+	struct TimerNode
+	{
+		int mTimerID;
+		Tick mDeadline;
+		int mBucket;	//level * NUM_SLOTS + slot, or the due or overflow bucket
+		int mPrev;
+		int mNext;
+	};
+
+	Tick ToTick(Clock::time_point time, bool roundUp) const;
+	Clock::time_point ToTime(Tick tick) const;
+
+	void Insert(int node);
+	void Link(int node, int bucket);
+	void Unlink(int node);
+	void FreeNode(int node);
+
+	//next tick where Advance has something to do: fire a bucket or spread one out
+	Tick GetNextEventTick() const;
+	void Cascade(int level);
+	void CascadeOverflow();
+	void Expire(int bucket, std::vector<int>& expiredTimers);
+
+	Clock::time_point mStart;
+	Clock::duration mTickLength;
+	Tick mCurrentTick;
+
+	std::vector<TimerNode> mNodes;
+	std::vector<int> mFreeNodes;
+	std::unordered_map<int, int> mNodeOfTimer;
+
+	//first node of each bucket, -1 when empty. After the wheel's buckets come one
+	// for timers that were already due when they were scheduled and one for
+	// timers too far off for the top level
+	std::vector<int> mBucketHeads;
+	//bit per slot with timers in it, one word per level
+	std::uint64_t mOccupied[NUM_LEVELS];
+	int mNumScheduled;
+};
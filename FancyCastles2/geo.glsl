@@ -5,11 +5,20 @@ layout(points) in;
 layout(triangle_strip, max_vertices = 12) out;
 
 in vec3 vColor[];
+flat in uint vFlags[];
 
-uniform vec2 selectedPoint;
+//world to clip space, from the renderer's Camera
+uniform mat4 viewProjection;
+
+//slot of the first tile in this draw call, gl_PrimitiveIDIn restarts at 0 for every call
+uniform int tileBase;
+
+//bit 0 of flags is set on the selected tile
+const uint TILE_FLAG_SELECTED = 1u;
 
 out vec3 fColor;
 out vec2 fTexcoord;
+flat out int fTileID;
 
 void main() 
 {
@@ -20,8 +29,6 @@ void main()
                           vec2(0.0, 0.0), 
                           vec2(0.0, 0.0), 
                           vec2(0.0, 0.0)); 
-	float w = 1366.f/100.f;
-	float h = 768.f/100.f;
 	vec2 verts[6]; 
 
 	// create the new verts of the hex and store them in an array to be triangulated 
@@ -30,12 +37,12 @@ void main()
 		float angle = 2.0 * PI / 6.0 * (corner + 0.5); 
 		float cornerX = gl_in[0].gl_Position.x + cos(angle);	
 		float cornerY = gl_in[0].gl_Position.y + sin(angle); 
-		verts[corner] = vec2(cornerX/w, cornerY/h); 
+		verts[corner] = vec2(cornerX, cornerY); 
 	}
     
-	// check to see if the tile selected from the pick is the current tile
+	// check to see if this is the selected tile
 	// if so, update the tex coordinates for so the selection texture appears  
-	if (selectedPoint.x == gl_in[0].gl_Position.x && selectedPoint.y == gl_in[0].gl_Position.y )
+	if ((vFlags[0] & TILE_FLAG_SELECTED) != 0u)
 	{ 
 		texc = vec2[](vec2(1.0, 0.75), 
 			          vec2(0.5, 1.0), 
@@ -50,14 +57,17 @@ void main()
 	int curVert = 0;
 	for(int triangle = 0; triangle < 4; triangle++) 
 	{
-		gl_Position =  vec4(verts[0].xy, 0.0, 1.0); 
+		gl_Position = viewProjection * vec4(verts[0].xy, 0.0, 1.0); 
 		fTexcoord = texc[0]; 
+		fTileID = tileBase + gl_PrimitiveIDIn; 
 		EmitVertex(); 
-		gl_Position =  vec4(verts[curVert+1].xy, 0.0, 1.0); 
+		gl_Position = viewProjection * vec4(verts[curVert+1].xy, 0.0, 1.0); 
 		fTexcoord = texc[curVert+1]; 
+		fTileID = tileBase + gl_PrimitiveIDIn; 
 		EmitVertex(); 
-		gl_Position =  vec4(verts[curVert+2].xy, 0.0, 1.0); 
+		gl_Position = viewProjection * vec4(verts[curVert+2].xy, 0.0, 1.0); 
 		fTexcoord = texc[curVert+2]; 
+		fTileID = tileBase + gl_PrimitiveIDIn; 
 		EmitVertex(); 
 		curVert++; 
 	} 
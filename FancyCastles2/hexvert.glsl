@@ -0,0 +1,38 @@
+#version 330 
+
+//one corner of the shared hex mesh
+in vec2 corner;
+in vec2 cornerTexcoord;
+
+//one tile per instance: axial r,q then type and flags
+in ivec2 axial;
+in uvec2 typeAndFlags;
+
+//world distance between neighboring columns and rows, from HexLayout.h
+uniform vec2 hexSpacing;
+uniform vec3 palette[8];
+
+out vec3 fColor;
+out vec2 fTexcoord;
+flat out int fTileID;
+
+//world to clip space, from the renderer's Camera
+uniform mat4 viewProjection;
+
+//slot of the first tile in this draw call, gl_InstanceID restarts at 0 for every call
+uniform int tileBase;
+
+//bit 0 of flags is set on the selected tile
+const uint TILE_FLAG_SELECTED = 1u;
+
+void main() 
+{
+   //only the selected tile samples the outline texture, everything else reads its empty corner
+   fTexcoord = (typeAndFlags.y & TILE_FLAG_SELECTED) != 0u ? cornerTexcoord : vec2(0.0, 0.0);
+   fColor = palette[typeAndFlags.x];
+   fTileID = tileBase + gl_InstanceID;
+
+   //axial.x is r, axial.y is q, same as HexLayout::GetCartesianFromAxial
+   vec2 position = vec2(hexSpacing.x * (float(axial.x) + 0.5 * float(axial.y)), -hexSpacing.y * float(axial.y));
+   gl_Position = viewProjection * vec4(position + corner, 0.0, 1.0);
+}
\ No newline at end of file
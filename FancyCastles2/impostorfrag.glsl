@@ -0,0 +1,27 @@
+#version 330 
+
+in vec2 fTexcoord;
+flat in int fChunk;
+
+out vec4 fragColor;
+
+//one IMPOSTOR_SIZE x IMPOSTOR_SIZE block of tile types per chunk, atlasColumns blocks to a row
+uniform usampler2D impostorAtlas;
+uniform int atlasColumns;
+uniform vec3 palette[8];
+
+//these match ChunkImpostors
+const int IMPOSTOR_SIZE = 16;
+const uint NO_TILE = 255u;
+
+void main()
+{
+   ivec2 texel = min(ivec2(fTexcoord * float(IMPOSTOR_SIZE)), ivec2(IMPOSTOR_SIZE - 1));
+   ivec2 chunkOrigin = ivec2(fChunk % atlasColumns, fChunk / atlasColumns) * IMPOSTOR_SIZE;
+   uint type = texelFetch(impostorAtlas, chunkOrigin + texel, 0).r;
+   if (type == NO_TILE)
+   {
+       discard;
+   }
+   fragColor = vec4(palette[type], 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#version 330 
+
+//one corner of a unit quad, stretched over the chunk
+in vec2 corner;
+
+//one chunk per instance: min x, min y, max x, max y in world units
+in vec4 chunkBounds;
+
+//world to clip space, from the renderer's Camera
+uniform mat4 viewProjection;
+
+out vec2 fTexcoord;
+flat out int fChunk;
+
+void main() 
+{
+   fTexcoord = corner;
+   fChunk = gl_InstanceID;
+   gl_Position = viewProjection * vec4(mix(chunkBounds.xy, chunkBounds.zw, corner), 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#version 330 
+
+flat in int fTileID;
+
+out uint pickID;
+
+void main()
+{
+   //0 is left for pixels with no tile on them
+   pickID = uint(fTileID) + 1u;
+}
\ No newline at end of file
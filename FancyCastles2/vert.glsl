@@ -1,12 +1,19 @@
 #version 330 
 
-in vec2 position;
-in vec3 color;
+in ivec2 axial;
+in uvec2 typeAndFlags;
+
+//world distance between neighboring columns and rows, from HexLayout.h
+uniform vec2 hexSpacing;
+uniform vec3 palette[8];
 
 out vec3 vColor;
+flat out uint vFlags;
 
 void main() 
 {
-   vColor = color;
-   gl_Position = vec4(position, 0.0, 1.0);
+   //axial.x is r, axial.y is q, same as HexLayout::GetCartesianFromAxial
+   vColor = palette[typeAndFlags.x];
+   vFlags = typeAndFlags.y;
+   gl_Position = vec4(hexSpacing.x * (float(axial.x) + 0.5 * float(axial.y)), -hexSpacing.y * float(axial.y), 0.0, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "gtest\gtest.h"
+
+#include "Board.h"
+#include "BoardChunks.h"
+
+namespace
+{
+	std::vector<AxialCoord>
+	GetTileCoords(const Board& board)
+	{
+		std::vector<AxialCoord> tileCoords;
+		for (int tileID = 0; tileID < board.GetNumTiles(); ++tileID)
+			tileCoords.push_back(board.GetTileCoord(tileID));
+		return tileCoords;
+	}
+
+	int
+	CountSlots(const TileSlotRangeList& ranges)
+	{
+		int numSlots = 0;
+		for (const auto& range : ranges)
+			numSlots += range.mEnd - range.mBegin;
+		return numSlots;
+	}
+}
+
+TEST(BoardChunksTest, testEveryTileInOneChunk)
+{
+	Board b;
+	b.MakeBoard(2000);
+	const auto tileCoords = GetTileCoords(b);
+	BoardChunks chunks(tileCoords);
+
+	EXPECT_GT(chunks.GetNumChunks(), 1);
+
+	//the chunks cover every slot once, in order, and every tile's hex fits its chunk's bounds
+	int nextSlot = 0;
+	for (int chunkIndex = 0; chunkIndex < chunks.GetNumChunks(); ++chunkIndex)
+	{
+		const auto& chunk = chunks.GetChunk(chunkIndex);
+		EXPECT_EQ(nextSlot, chunk.mFirstSlot);
+		EXPECT_GT(chunk.mNumTiles, 0);
+		EXPECT_LE(chunk.mNumTiles, BoardChunks::CHUNK_SIZE * BoardChunks::CHUNK_SIZE);
+
+		for (int slot = chunk.mFirstSlot; slot < chunk.mFirstSlot + chunk.mNumTiles; ++slot)
+		{
+			const auto tileID = chunks.GetSlotTile(slot);
+			EXPECT_EQ(slot, chunks.GetTileSlot(tileID));
+			EXPECT_EQ(chunkIndex, chunks.GetSlotChunk(slot));
+
+			float x, y;
+			HexLayout::GetCartesianFromAxial(x, y, tileCoords[tileID]);
+			EXPECT_TRUE(chunk.mBounds.Intersects(HexLayout::WorldRect(x - HexLayout::HEX_SIZE, y - HexLayout::HEX_SIZE, x - HexLayout::HEX_SIZE, y - HexLayout::HEX_SIZE)));
+			EXPECT_TRUE(chunk.mBounds.Intersects(HexLayout::WorldRect(x + HexLayout::HEX_SIZE, y + HexLayout::HEX_SIZE, x + HexLayout::HEX_SIZE, y + HexLayout::HEX_SIZE)));
+		}
+		nextSlot += chunk.mNumTiles;
+	}
+	EXPECT_EQ(b.GetNumTiles(), nextSlot);
+}
+
+TEST(BoardChunksTest, testFindVisibleSlots)
+{
+	Board b;
+	b.MakeBoard(2000);
+	const auto tileCoords = GetTileCoords(b);
+	BoardChunks chunks(tileCoords);
+
+	//a view over the whole board draws everything in one run
+	TileSlotRangeList ranges;
+	chunks.FindVisibleSlots(HexLayout::WorldRect(-1e4f, -1e4f, 1e4f, 1e4f), ranges);
+	ASSERT_EQ(1u, ranges.size());
+	EXPECT_EQ(0, ranges[0].mBegin);
+	EXPECT_EQ(b.GetNumTiles(), ranges[0].mEnd);
+
+	//a view off the board draws nothing
+	chunks.FindVisibleSlots(HexLayout::WorldRect(1e4f, 1e4f, 1e4f + 10.f, 1e4f + 10.f), ranges);
+	EXPECT_TRUE(ranges.empty());
+
+	//a small view draws a fraction of the board, including every tile it touches
+	const HexLayout::WorldRect view(-3.f, -3.f, 3.f, 3.f);
+	chunks.FindVisibleSlots(view, ranges);
+	EXPECT_GT(CountSlots(ranges), 0);
+	EXPECT_LT(CountSlots(ranges), b.GetNumTiles() / 2);
+
+	for (size_t i = 1; i < ranges.size(); ++i)
+		EXPECT_LT(ranges[i - 1].mEnd, ranges[i].mBegin);
+
+	for (int tileID = 0; tileID < b.GetNumTiles(); ++tileID)
+	{
+		float x, y;
+		HexLayout::GetCartesianFromAxial(x, y, tileCoords[tileID]);
+		if (!view.Intersects(HexLayout::WorldRect(x, y, x, y)))
+			continue;
+
+		const auto slot = chunks.GetTileSlot(tileID);
+		bool drawn = false;
+		for (const auto& range : ranges)
+			drawn = drawn || (slot >= range.mBegin && slot < range.mEnd);
+		EXPECT_TRUE(drawn);
+	}
+}
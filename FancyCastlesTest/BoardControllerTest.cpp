@@ -0,0 +1,268 @@
+#include "gtest\gtest.h"
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <unordered_map>
+
+#include "BoardController.h"
+#include "BoardControllerTestSetup.h"
+
+namespace
+{
+	TileIDSet
+	MakeRandomTileSet(int numTiles, double density, std::mt19937& rng)
+	{
+		std::bernoulli_distribution inSet(density);
+		TileIDSet tiles;
+		for (int tileID = 0; tileID < numTiles; ++tileID)
+		{
+			if (inSet(rng))
+				tiles.insert(tileID);
+		}
+
+		return tiles;
+	}
+
+	//plain breadth first search to check the bitboard flood fill against
+	TileIDSet
+	ReferenceComponent(const BoardController& bc, const TileIDSet& tiles, int source)
+	{
+		TileIDSet component;
+		if (tiles.count(source) == 0)
+			return component;
+
+		std::queue<int> toVisit;
+		toVisit.push(source);
+		component.insert(source);
+		while (!toVisit.empty())
+		{
+			const auto cur = toVisit.front();
+			toVisit.pop();
+			for (auto neighbor : bc.GetNeighbors(cur))
+			{
+				if (tiles.count(neighbor) > 0 && component.insert(neighbor).second)
+					toVisit.push(neighbor);
+			}
+		}
+
+		return component;
+	}
+
+	//breadth first distances from source through the tile set, unreachable tiles are left out
+	std::unordered_map<int, int>
+	ReferenceDistances(const BoardController& bc, const TileIDSet& tiles, int source)
+	{
+		std::unordered_map<int, int> distances;
+		std::queue<int> toVisit;
+		toVisit.push(source);
+		distances[source] = 0;
+		while (!toVisit.empty())
+		{
+			const auto cur = toVisit.front();
+			toVisit.pop();
+			for (auto neighbor : bc.GetNeighbors(cur))
+			{
+				if (tiles.count(neighbor) > 0 && distances.count(neighbor) == 0)
+				{
+					distances[neighbor] = distances[cur] + 1;
+					toVisit.push(neighbor);
+				}
+			}
+		}
+
+		return distances;
+	}
+}
+
+TEST(TileBitSetTest, testSetOperations)
+{
+	TileBitSet a(130);
+	TileBitSet b(130);
+	EXPECT_TRUE(a.None());
+	EXPECT_EQ(3, a.GetNumWords());
+
+	a.Set(0);
+	a.Set(64);
+	a.Set(129);
+	b.Set(64);
+	b.Set(100);
+
+	EXPECT_EQ(3, a.Count());
+	EXPECT_TRUE(a.Test(129));
+	EXPECT_FALSE(a.Test(130));
+	EXPECT_EQ(4, (a | b).Count());
+	EXPECT_EQ(1, (a & b).Count());
+	EXPECT_EQ(2, (a - b).Count());
+
+	a.Reset(0);
+	EXPECT_FALSE(a.Test(0));
+	EXPECT_EQ((TileIDSet{ 64, 129 }), a.ToTileIDSet());
+}
+
+TEST(TileBitSetTest, testOrShiftedRange)
+{
+	TileBitSet src(200);
+	for (int i = 10; i < 150; i += 3)
+		src.Set(i);
+
+	for (int delta = -9; delta <= 49; delta += 7)
+	{
+		TileBitSet dst(200);
+		dst.OrShiftedRange(src, 10, 140, delta);
+		for (int i = 0; i < 200; ++i)
+			EXPECT_EQ(src.Test(i - delta), dst.Test(i));
+	}
+}
+
+TEST(BoardControllerTest, testFindConnectedComponent)
+{
+	std::mt19937 rng(1234);
+	for (int numTilesPerType = 2; numTilesPerType <= 200; numTilesPerType *= 3)
+	{
+		const auto bc = MakeController(numTilesPerType);
+		const auto numTiles = bc->GetNumTiles();
+		for (int trial = 0; trial < 20; ++trial)
+		{
+			const auto tiles = MakeRandomTileSet(numTiles, 0.6, rng);
+			const int source = rng() % numTiles;
+			EXPECT_EQ(ReferenceComponent(*bc, tiles, source), bc->FindConnectedComponent(tiles, source));
+		}
+	}
+}
+
+TEST(BoardControllerTest, testFindConnectedComponentSourceNotInSet)
+{
+	const auto bc = MakeController(10);
+	EXPECT_TRUE(bc->FindConnectedComponent(TileIDSet{ 1, 2, 3 }, 0).empty());
+}
+
+TEST(BoardControllerTest, testFindConnectedPath)
+{
+	std::mt19937 rng(4321);
+	for (int numTilesPerType = 2; numTilesPerType <= 200; numTilesPerType *= 3)
+	{
+		const auto bc = MakeController(numTilesPerType);
+		const auto numTiles = bc->GetNumTiles();
+		for (int trial = 0; trial < 20; ++trial)
+		{
+			auto tiles = MakeRandomTileSet(numTiles, 0.7, rng);
+			const int source = rng() % numTiles;
+			const int target = rng() % numTiles;
+			tiles.insert(source);
+			tiles.insert(target);
+
+			const auto distances = ReferenceDistances(*bc, tiles, source);
+			const auto path = bc->FindConnectedPath(tiles, source, target);
+			if (distances.count(target) == 0)
+			{
+				EXPECT_TRUE(path.empty());
+				continue;
+			}
+
+			//shortest path, made of neighboring tiles from the set
+			ASSERT_EQ(distances.at(target) + 1, static_cast<int>(path.size()));
+			EXPECT_EQ(source, path.front());
+			EXPECT_EQ(target, path.back());
+			for (size_t i = 0; i < path.size(); ++i)
+			{
+				EXPECT_EQ(1u, tiles.count(path[i]));
+				if (i > 0)
+				{
+					const auto neighbors = bc->GetNeighbors(path[i - 1]);
+					EXPECT_NE(neighbors.end(), std::find(neighbors.begin(), neighbors.end(), path[i]));
+				}
+			}
+		}
+	}
+}
+
+TEST(BoardControllerTest, testFindConnectedPathOutsideSet)
+{
+	const auto bc = MakeController(10);
+	EXPECT_TRUE(bc->FindConnectedPath(TileIDSet{ 1, 2, 3 }, 0, 2).empty());
+	EXPECT_EQ(TileIDList{ 1 }, bc->FindConnectedPath(TileIDSet{ 1, 2, 3 }, 1, 1));
+}
+
+TEST(BoardControllerTest, testFindConnectedPaths)
+{
+	std::mt19937 rng(99);
+	const auto bc = MakeController(50);
+	const auto numTiles = bc->GetNumTiles();
+	const auto tiles = MakeRandomTileSet(numTiles, 0.8, rng);
+	const TileBitSet tileBits(numTiles, tiles);
+
+	TilePathQueryList queries;
+	for (int i = 0; i < 50; ++i)
+		queries.emplace_back(rng() % numTiles, rng() % numTiles);
+
+	TilePathList paths;
+	bc->FindConnectedPaths(tileBits, queries, paths);
+	ASSERT_EQ(queries.size(), paths.size());
+	for (size_t i = 0; i < queries.size(); ++i)
+		EXPECT_EQ(bc->FindConnectedPath(tiles, queries[i].first, queries[i].second), paths[i]);
+}
+
+TEST(BoardControllerTest, testTileRanges)
+{
+	auto bc = MakeController(10);
+	EXPECT_TRUE(bc->GetTilesInRange(-1, 2).empty());
+	EXPECT_TRUE(bc->GetTilesInRing(bc->GetNumTiles(), 2).empty());
+	EXPECT_TRUE(bc->GetTilesOnLine(0, -1).empty());
+
+	//the radius one ring is the neighbor list
+	for (int tileID = 0; tileID < bc->GetNumTiles(); ++tileID)
+	{
+		const auto ring = bc->GetTilesInRing(tileID, 1);
+		EXPECT_EQ(bc->FindNeighbors(tileID), TileIDSet(ring.begin(), ring.end()));
+	}
+}
+
+TEST(BoardControllerTest, testHasLineOfSight)
+{
+	auto bc = MakeController(10);
+	const auto water = ToResourceTypeMask(ResourceType::WATER);
+	for (int source = 0; source < bc->GetNumTiles(); ++source)
+	{
+		for (int target = 0; target < bc->GetNumTiles(); ++target)
+		{
+			bool blocked = false;
+			const auto line = bc->GetTilesOnLine(source, target);
+			for (auto tileID : line)
+			{
+				if (tileID != source && tileID != target && bc->GetTileType(tileID) == ResourceType::WATER)
+					blocked = true;
+			}
+
+			EXPECT_EQ(!blocked, bc->HasLineOfSight(source, target, water));
+			EXPECT_TRUE(bc->HasLineOfSight(source, target, 0));
+		}
+	}
+
+	EXPECT_FALSE(bc->HasLineOfSight(-1, 0, 0));
+}
+
+//run with --gtest_also_run_disabled_tests to time path queries on large boards
+TEST(BoardControllerTest, DISABLED_benchmarkFindConnectedPaths)
+{
+	std::mt19937 rng(7);
+	for (int numTilesPerType : { 2000, 20000, 200000 })
+	{
+		const auto bc = MakeController(numTilesPerType);
+		const auto numTiles = bc->GetNumTiles();
+		const TileBitSet tiles(numTiles, MakeRandomTileSet(numTiles, 0.75, rng));
+
+		TilePathQueryList queries;
+		for (int i = 0; i < 1000; ++i)
+			queries.emplace_back(rng() % numTiles, rng() % numTiles);
+
+		TilePathList paths;
+		bc->FindConnectedPaths(tiles, queries, paths);
+
+		const auto start = std::chrono::steady_clock::now();
+		bc->FindConnectedPaths(tiles, queries, paths);
+		const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+		std::cout << numTiles << " tiles: " << elapsed.count() / queries.size() << " us per path query" << std::endl;
+	}
+}
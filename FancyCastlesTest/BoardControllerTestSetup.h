@@ -0,0 +1,15 @@
+#pragma once
+
+#include <memory>
+
+#include "Board.h"
+#include "BoardController.h"
+
+//a controller over a fresh board with numTilesPerType tiles of each type
+inline std::unique_ptr<BoardController>
+MakeController(int numTilesPerType)
+{
+	auto board = std::make_unique<Board>();
+	board->MakeBoard(numTilesPerType);
+	return std::make_unique<BoardController>(std::move(board));
+}
@@ -1,7 +1,14 @@
 #include "gtest\gtest.h"
 #include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Board.h"
+#include "HexMath.h"
+#include "TileBitSet.h"
 
 TEST(BoardTest, testConstructor)
 {
@@ -161,6 +168,304 @@ TEST(BoardTest, testIsPositionValid)
 	}
 }
 
+void
+testTileIndexRoundTrip(const int& numPlayers)
+{
+	Board b;
+	b.MakeBoard(numPlayers);
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+	{
+		EXPECT_EQ(i, b.GetTileIndex(b.GetTileCoord(i)));
+	}
+}
+
+TEST(BoardTest, testTileIndexRoundTrip)
+{
+	for (int i = 2; i <= 10; ++i)
+	{
+		testTileIndexRoundTrip(i);
+	}
+
+	//large enough to give a board with a radius in the hundreds
+	testTileIndexRoundTrip(50000);
+}
+
+void
+testNeighbors(const int& numPlayers)
+{
+	Board b;
+	b.MakeBoard(numPlayers);
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+	{
+		const auto pos = b.GetTileCoord(i);
+		const auto neighbors = b.GetNeighbors(i);
+		EXPECT_LE(neighbors.size(), 6);
+
+		for (auto neighbor : neighbors)
+		{
+			//every neighbor is one step away and sees this tile as a neighbor too
+			const auto neighborPos = b.GetTileCoord(neighbor);
+			const int dr = neighborPos.r - pos.r;
+			const int dq = neighborPos.q - pos.q;
+			EXPECT_EQ(1, (std::abs(dr) + std::abs(dq) + std::abs(dr + dq)) / 2);
+
+			const auto backLinks = b.GetNeighbors(neighbor);
+			EXPECT_NE(backLinks.end(), std::find(backLinks.begin(), backLinks.end(), i));
+		}
+	}
+
+	//the center tile is surrounded
+	EXPECT_EQ(6, b.GetNeighbors(b.GetTileIndex(AxialCoord(0, 0))).size());
+}
+
+TEST(BoardTest, testNeighbors)
+{
+	for (int i = 2; i <= 10; ++i)
+	{
+		testNeighbors(i);
+	}
+}
+
+std::vector<ResourceType>
+getTileTypes(const Board& b)
+{
+	std::vector<ResourceType> types;
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+		types.push_back(b.GetTileType(i));
+
+	return types;
+}
+
+TEST(BoardTest, testMakeBoardSeed)
+{
+	//large enough that the shuffle has to merge several blocks
+	for (int numPlayers : { 6, 40000 })
+	{
+		Board a;
+		a.MakeBoard(numPlayers, 12345);
+		Board b;
+		b.MakeBoard(numPlayers, 12345);
+		Board c;
+		c.MakeBoard(numPlayers, 54321);
+
+		EXPECT_EQ(12345u, a.GetSeed());
+		EXPECT_EQ(getTileTypes(a), getTileTypes(b));
+		EXPECT_NE(getTileTypes(a), getTileTypes(c));
+	}
+
+	//the parallel shuffle still keeps every tile
+	testMakeBoardTileTypes(40000);
+}
+
+TEST(BoardTest, testTileView)
+{
+	Board b;
+	b.MakeBoard(6, 3);
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+	{
+		auto tile = b.GetTile(i);
+		EXPECT_EQ(i, tile.GetTileID());
+		EXPECT_EQ(b.GetTileType(i), tile.GetTileType());
+
+		tile.SetHarvestRate(4);
+		EXPECT_EQ(b.GetHarvestRate(i), tile.GetHarvestRate());
+	}
+}
+
+TEST(BoardTest, testGetHarvestTotals)
+{
+	std::mt19937 rng(11);
+	for (int numPlayers : { 6, 100 })
+	{
+		Board b;
+		b.MakeBoard(numPlayers, 5);
+		for (int tile = 0; tile < b.GetNumTiles(); ++tile)
+			b.SetHarvestRate(tile, 1 + rng() % 9);
+
+		for (int trial = 0; trial < 10; ++trial)
+		{
+			TileBitSet tiles(b.GetNumTiles());
+			ResourceTotals expected = {};
+			for (int tile = 0; tile < b.GetNumTiles(); ++tile)
+			{
+				if (rng() % 2 == 0)
+					continue;
+
+				tiles.Set(tile);
+				expected[static_cast<int>(b.GetTileType(tile))] += b.GetHarvestRate(tile);
+			}
+
+			EXPECT_EQ(expected, b.GetHarvestTotals(tiles));
+		}
+	}
+}
+
+void
+testTileOrdering(const int& numPlayers, TileOrdering ordering)
+{
+	Board b;
+	b.MakeBoard(numPlayers, 1, ordering);
+	EXPECT_EQ(ordering, b.GetTileOrdering());
+
+	std::unordered_set<AxialCoord> seenCoords;
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+	{
+		const auto pos = b.GetTileCoord(i);
+		EXPECT_TRUE(b.IsPositionValid(pos));
+		EXPECT_TRUE(seenCoords.insert(pos).second);
+		EXPECT_EQ(i, b.GetTileIndex(pos));
+	}
+
+	//every shift run has to agree with the neighbor table
+	int numShiftedTiles = 0;
+	for (const auto& run : b.GetNeighborShiftRuns())
+	{
+		for (int i = run.mStart; i < run.mStart + run.mLength; ++i)
+		{
+			const auto neighbors = b.GetNeighbors(i);
+			EXPECT_NE(neighbors.end(), std::find(neighbors.begin(), neighbors.end(), i + run.mDelta));
+			numShiftedTiles++;
+		}
+	}
+
+	int numNeighbors = 0;
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+		numNeighbors += b.GetNeighbors(i).size();
+
+	EXPECT_EQ(numNeighbors, numShiftedTiles);
+}
+
+TEST(BoardTest, testTileOrderings)
+{
+	for (auto ordering : { TileOrdering::COLUMNS, TileOrdering::SPIRAL, TileOrdering::MORTON })
+	{
+		for (int i = 2; i <= 10; ++i)
+			testTileOrdering(i, ordering);
+
+		testTileOrdering(2000, ordering);
+	}
+
+	Board b;
+	b.MakeBoard(10, 1, TileOrdering::SPIRAL);
+	EXPECT_EQ(AxialCoord(0, 0), b.GetTileCoord(0));
+	EXPECT_EQ(6, b.GetNeighbors(0).size());
+	for (auto neighbor : b.GetNeighbors(0))
+	{
+		//the first ring comes straight after the center
+		EXPECT_GE(neighbor, 1);
+		EXPECT_LE(neighbor, 6);
+	}
+}
+
+void
+testTileRanges(const Board& b, const AxialCoord& center, int radius)
+{
+	//check each range against a scan of the whole board
+	std::unordered_set<int> expectedArea, expectedRing;
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+	{
+		const auto distance = HexMath::Distance(b.GetTileCoord(i), center);
+		if (distance <= radius)
+			expectedArea.insert(i);
+		if (distance == radius)
+			expectedRing.insert(i);
+	}
+
+	std::unordered_set<int> area;
+	for (auto tileID : b.GetTilesInRange(center, radius))
+		EXPECT_TRUE(area.insert(tileID).second);
+	EXPECT_EQ(expectedArea, area);
+
+	std::unordered_set<int> ring;
+	for (auto tileID : b.GetTilesInRing(center, radius))
+		EXPECT_TRUE(ring.insert(tileID).second);
+	EXPECT_EQ(expectedRing, ring);
+}
+
+TEST(BoardTest, testTileRanges)
+{
+	for (auto ordering : { TileOrdering::COLUMNS, TileOrdering::SPIRAL, TileOrdering::MORTON })
+	{
+		Board b;
+		b.MakeBoard(10, 1, ordering);
+		for (int radius = 0; radius <= 9; ++radius)
+		{
+			testTileRanges(b, AxialCoord(0, 0), radius);
+			testTileRanges(b, AxialCoord(2, -4), radius);
+			testTileRanges(b, AxialCoord(-6, 1), radius);
+		}
+	}
+
+	Board b;
+	b.MakeBoard(10);
+	EXPECT_TRUE(b.GetTilesInRange(AxialCoord(20, 20), 3).empty());
+	EXPECT_TRUE(b.GetTilesInRing(AxialCoord(), -1).empty());
+	EXPECT_EQ(1, std::distance(b.GetTilesInRing(AxialCoord(), 0).begin(), b.GetTilesInRing(AxialCoord(), 0).end()));
+}
+
+TEST(BoardTest, testTilesOnLine)
+{
+	Board b;
+	b.MakeBoard(10, 1, TileOrdering::SPIRAL);
+	for (int from = 0; from < b.GetNumTiles(); from += 5)
+	{
+		for (int to = 0; to < b.GetNumTiles(); ++to)
+		{
+			//the line runs from one end to the other in single steps
+			const auto line = b.GetTilesOnLine(b.GetTileCoord(from), b.GetTileCoord(to));
+			std::vector<int> tiles(line.begin(), line.end());
+			ASSERT_EQ(HexMath::Distance(b.GetTileCoord(from), b.GetTileCoord(to)) + 1, static_cast<int>(tiles.size()));
+			EXPECT_EQ(from, tiles.front());
+			EXPECT_EQ(to, tiles.back());
+			for (size_t i = 1; i < tiles.size(); ++i)
+				EXPECT_EQ(1, HexMath::Distance(b.GetTileCoord(tiles[i - 1]), b.GetTileCoord(tiles[i])));
+		}
+	}
+
+	//a line that leaves the board only yields the part on the board
+	const auto line = b.GetTilesOnLine(AxialCoord(0, -8), AxialCoord(0, 8));
+	EXPECT_EQ(9, std::distance(line.begin(), line.end()));
+}
+
+//run with --gtest_also_run_disabled_tests to compare how the orderings do on walks over the board
+TEST(BoardTest, DISABLED_benchmarkTileOrderings)
+{
+	const char* orderingNames[] = { "columns", "spiral", "morton" };
+	for (int numPlayers : { 1530, 150300 })
+	{
+		for (auto ordering : { TileOrdering::COLUMNS, TileOrdering::SPIRAL, TileOrdering::MORTON })
+		{
+			Board b;
+			b.MakeBoard(numPlayers, 1, ordering);
+			const int numTiles = b.GetNumTiles();
+			const auto start = std::chrono::steady_clock::now();
+
+			//breadth first search over the whole board from the center
+			std::vector<int> visited(numTiles, 0);
+			std::vector<int> queue;
+			queue.reserve(numTiles);
+			queue.push_back(b.GetTileIndex(AxialCoord(0, 0)));
+			visited[queue.front()] = 1;
+			long long checksum = 0;
+			for (size_t head = 0; head < queue.size(); ++head)
+			{
+				for (auto neighbor : b.GetNeighbors(queue[head]))
+				{
+					checksum += neighbor;
+					if (!visited[neighbor])
+					{
+						visited[neighbor] = 1;
+						queue.push_back(neighbor);
+					}
+				}
+			}
+
+			const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+			std::cout << numTiles << " tiles, " << orderingNames[static_cast<int>(ordering)] << ": "
+				<< elapsed.count() << " ms full board search (" << checksum << ")" << std::endl;
+		}
+	}
+}
 
 int main(int argc, char **argv)
 {
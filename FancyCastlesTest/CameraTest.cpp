@@ -0,0 +1,83 @@
+#include "gtest\gtest.h"
+
+#include "Camera.h"
+
+TEST(CameraTest, testWindowToWorld)
+{
+	//the default camera shows the same part of the world the renderer always has
+	Camera camera(1366.f, 768.f);
+	float x, y;
+	camera.WindowToWorld(x, y, 683.0, 384.0);
+	EXPECT_EQ(0.f, x);
+	EXPECT_EQ(0.f, y);
+
+	camera.WindowToWorld(x, y, 0.0, 768.0);
+	EXPECT_EQ(-HexLayout::VIEW_HALF_WIDTH, x);
+	EXPECT_EQ(HexLayout::VIEW_HALF_HEIGHT, y);
+
+	//and back again from somewhere else
+	camera.SetCenter(-4.f, 9.f);
+	camera.SetZoom(3.f);
+	float windowX, windowY;
+	camera.WindowToWorld(x, y, 100.0, 500.0);
+	camera.WorldToWindow(windowX, windowY, x, y);
+	EXPECT_NEAR(100.f, windowX, 1e-3f);
+	EXPECT_NEAR(500.f, windowY, 1e-3f);
+}
+
+TEST(CameraTest, testViewProjection)
+{
+	//the corners of the view bounds land on the corners of clip space
+	Camera camera(1366.f, 768.f);
+	camera.SetCenter(12.f, -30.f);
+	camera.SetZoom(0.5f);
+
+	float m[16];
+	camera.GetViewProjection(m);
+	const auto view = camera.GetViewBounds();
+
+	EXPECT_NEAR(-1.f, m[0] * view.mMinX + m[12], 1e-5f);
+	EXPECT_NEAR(-1.f, m[5] * view.mMinY + m[13], 1e-5f);
+	EXPECT_NEAR(1.f, m[0] * view.mMaxX + m[12], 1e-5f);
+	EXPECT_NEAR(1.f, m[5] * view.mMaxY + m[13], 1e-5f);
+	EXPECT_NEAR(2.f * HexLayout::VIEW_HALF_WIDTH / 0.5f, view.mMaxX - view.mMinX, 1e-4f);
+}
+
+TEST(CameraTest, testPan)
+{
+	//panning the whole window width moves the view by its whole width
+	Camera camera(1366.f, 768.f);
+	camera.SetZoom(2.f);
+	camera.Pan(1366.f, -768.f);
+
+	float x, y;
+	camera.GetCenter(x, y);
+	EXPECT_NEAR(HexLayout::VIEW_HALF_WIDTH, x, 1e-5f);
+	EXPECT_NEAR(-HexLayout::VIEW_HALF_HEIGHT, y, 1e-5f);
+}
+
+TEST(CameraTest, testZoomKeepsPointUnderMouse)
+{
+	Camera camera(1366.f, 768.f);
+	camera.SetCenter(5.f, 5.f);
+
+	float beforeX, beforeY;
+	camera.WindowToWorld(beforeX, beforeY, 200.0, 600.0);
+	camera.ZoomAt(4.f, 200.0, 600.0);
+	EXPECT_EQ(4.f, camera.GetZoom());
+
+	float afterX, afterY;
+	camera.WindowToWorld(afterX, afterY, 200.0, 600.0);
+	EXPECT_NEAR(beforeX, afterX, 1e-4f);
+	EXPECT_NEAR(beforeY, afterY, 1e-4f);
+}
+
+TEST(CameraTest, testZoomLimits)
+{
+	Camera camera(1366.f, 768.f);
+	camera.SetZoom(1000.f);
+	EXPECT_EQ(Camera::GetMaxZoom(), camera.GetZoom());
+
+	camera.ZoomAt(1e-6f, 0.0, 0.0);
+	EXPECT_EQ(Camera::GetMinZoom(), camera.GetZoom());
+}
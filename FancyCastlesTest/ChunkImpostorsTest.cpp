@@ -0,0 +1,114 @@
+#include "gtest\gtest.h"
+
+#include "Board.h"
+#include "ChunkImpostors.h"
+
+namespace
+{
+	const int TEXELS_PER_CHUNK = ChunkImpostors::IMPOSTOR_SIZE * ChunkImpostors::IMPOSTOR_SIZE;
+
+	struct ImpostorBoard
+	{
+		Board mBoard;
+		BoardChunks mChunks;
+		std::vector<unsigned char> mSlotTypes;
+
+		explicit ImpostorBoard(int numTilesPerType)
+		{
+			mBoard.MakeBoard(numTilesPerType);
+
+			std::vector<AxialCoord> tileCoords;
+			for (int tileID = 0; tileID < mBoard.GetNumTiles(); ++tileID)
+				tileCoords.push_back(mBoard.GetTileCoord(tileID));
+			mChunks = BoardChunks(tileCoords);
+
+			for (int slot = 0; slot < mBoard.GetNumTiles(); ++slot)
+				mSlotTypes.push_back(static_cast<unsigned char>(mBoard.GetTileType(mChunks.GetSlotTile(slot))));
+		}
+
+		void Update(ChunkImpostors& impostors, std::vector<int>& rebuiltChunks) const
+		{
+			impostors.UpdateDirty(mChunks, mBoard.GetIndexView(), mSlotTypes.data(), 1, rebuiltChunks);
+		}
+	};
+}
+
+TEST(ChunkImpostorsTest, testTexelsComeFromTheirChunk)
+{
+	ImpostorBoard b(2000);
+	ChunkImpostors impostors(b.mChunks.GetNumChunks());
+	EXPECT_TRUE(impostors.AnyDirty());
+
+	std::vector<int> rebuiltChunks;
+	b.Update(impostors, rebuiltChunks);
+	EXPECT_FALSE(impostors.AnyDirty());
+	EXPECT_EQ(b.mChunks.GetNumChunks(), static_cast<int>(rebuiltChunks.size()));
+
+	//every texel is empty or the type of one of the chunk's own tiles
+	for (int chunkIndex = 0; chunkIndex < b.mChunks.GetNumChunks(); ++chunkIndex)
+	{
+		const auto& chunk = b.mChunks.GetChunk(chunkIndex);
+		bool chunkTypes[static_cast<int>(ResourceType::NUMTYPES)] = {};
+		for (int slot = chunk.mFirstSlot; slot < chunk.mFirstSlot + chunk.mNumTiles; ++slot)
+			chunkTypes[b.mSlotTypes[slot]] = true;
+
+		int numFilled = 0;
+		const auto texels = impostors.GetTexels(chunkIndex);
+		for (int texel = 0; texel < TEXELS_PER_CHUNK; ++texel)
+		{
+			if (texels[texel] == ChunkImpostors::NO_TILE)
+				continue;
+
+			ASSERT_TRUE(texels[texel] < static_cast<int>(ResourceType::NUMTYPES));
+			EXPECT_TRUE(chunkTypes[texels[texel]]);
+			numFilled++;
+		}
+		EXPECT_GT(numFilled, 0);
+	}
+}
+
+TEST(ChunkImpostorsTest, testIncrementalUpdate)
+{
+	ImpostorBoard b(2000);
+	ChunkImpostors impostors(b.mChunks.GetNumChunks());
+	std::vector<int> rebuiltChunks;
+	b.Update(impostors, rebuiltChunks);
+
+	const std::vector<unsigned char> before(impostors.GetTexels(0), impostors.GetTexels(0) + TEXELS_PER_CHUNK * b.mChunks.GetNumChunks());
+
+	//flood one chunk with water, only that chunk gets rebuilt
+	const int floodedChunk = b.mChunks.GetNumChunks() / 2;
+	const auto& chunk = b.mChunks.GetChunk(floodedChunk);
+	for (int slot = chunk.mFirstSlot; slot < chunk.mFirstSlot + chunk.mNumTiles; ++slot)
+	{
+		b.mSlotTypes[slot] = static_cast<unsigned char>(ResourceType::WATER);
+		impostors.MarkChunkDirty(b.mChunks.GetSlotChunk(slot));
+	}
+
+	b.Update(impostors, rebuiltChunks);
+	ASSERT_EQ(1u, rebuiltChunks.size());
+	EXPECT_EQ(floodedChunk, rebuiltChunks[0]);
+
+	for (int chunkIndex = 0; chunkIndex < b.mChunks.GetNumChunks(); ++chunkIndex)
+	{
+		const auto texels = impostors.GetTexels(chunkIndex);
+		for (int texel = 0; texel < TEXELS_PER_CHUNK; ++texel)
+		{
+			if (chunkIndex != floodedChunk)
+			{
+				EXPECT_EQ(before[chunkIndex * TEXELS_PER_CHUNK + texel], texels[texel]);
+			}
+			else if (texels[texel] != ChunkImpostors::NO_TILE)
+			{
+				EXPECT_EQ(static_cast<unsigned char>(ResourceType::WATER), texels[texel]);
+			}
+		}
+	}
+}
+
+TEST(ChunkImpostorsTest, testShouldDraw)
+{
+	//hexes tens of pixels across are drawn, hexes a pixel across aren't
+	EXPECT_FALSE(ChunkImpostors::ShouldDraw(50.f));
+	EXPECT_TRUE(ChunkImpostors::ShouldDraw(0.5f));
+}
@@ -0,0 +1,71 @@
+#include "gtest\gtest.h"
+
+#include "DirtyTileRanges.h"
+
+TEST(DirtyTileRangesTest, testNothingDirty)
+{
+	DirtyTileRanges dirty(100);
+	EXPECT_FALSE(dirty.Any());
+
+	DirtyTileRangeList ranges;
+	dirty.TakeRanges(0, ranges);
+	EXPECT_TRUE(ranges.empty());
+}
+
+TEST(DirtyTileRangesTest, testTakeRanges)
+{
+	DirtyTileRanges dirty(200);
+	for (auto tileID : { 5, 3, 4, 4, 10, 130, 199 })
+		dirty.MarkDirty(tileID);
+
+	EXPECT_TRUE(dirty.Any());
+	EXPECT_EQ(6, dirty.Count());
+
+	DirtyTileRangeList ranges;
+	dirty.TakeRanges(0, ranges);
+	ASSERT_EQ(4u, ranges.size());
+	EXPECT_EQ(3, ranges[0].mBegin);
+	EXPECT_EQ(6, ranges[0].mEnd);
+	EXPECT_EQ(10, ranges[1].mBegin);
+	EXPECT_EQ(11, ranges[1].mEnd);
+	EXPECT_EQ(130, ranges[2].mBegin);
+	EXPECT_EQ(199, ranges[3].mBegin);
+	EXPECT_EQ(200, ranges[3].mEnd);
+
+	//taking the ranges leaves everything clean
+	EXPECT_FALSE(dirty.Any());
+	dirty.TakeRanges(0, ranges);
+	EXPECT_TRUE(ranges.empty());
+}
+
+TEST(DirtyTileRangesTest, testMergeNearbyRanges)
+{
+	DirtyTileRanges dirty(200);
+	for (auto tileID : { 3, 10, 130 })
+		dirty.MarkDirty(tileID);
+
+	DirtyTileRangeList ranges;
+	dirty.TakeRanges(8, ranges);
+	ASSERT_EQ(2u, ranges.size());
+	EXPECT_EQ(3, ranges[0].mBegin);
+	EXPECT_EQ(11, ranges[0].mEnd);
+	EXPECT_EQ(130, ranges[1].mBegin);
+
+	//exactly maxGap clean tiles between runs still merges them, one more doesn't
+	for (auto tileID : { 20, 29, 50, 60 })
+		dirty.MarkDirty(tileID);
+	dirty.TakeRanges(8, ranges);
+	ASSERT_EQ(3u, ranges.size());
+	EXPECT_EQ(20, ranges[0].mBegin);
+	EXPECT_EQ(30, ranges[0].mEnd);
+	EXPECT_EQ(50, ranges[1].mBegin);
+	EXPECT_EQ(51, ranges[1].mEnd);
+	EXPECT_EQ(60, ranges[2].mBegin);
+
+	dirty.MarkAllDirty();
+	EXPECT_EQ(200, dirty.Count());
+	dirty.TakeRanges(0, ranges);
+	ASSERT_EQ(1u, ranges.size());
+	EXPECT_EQ(0, ranges[0].mBegin);
+	EXPECT_EQ(200, ranges[0].mEnd);
+}
@@ -0,0 +1,60 @@
+#include "gtest\gtest.h"
+
+#include <cmath>
+
+#include "FramePacer.h"
+
+namespace
+{
+	FramePacer::Clock::time_point
+	AfterMilliseconds(FramePacer::Clock::time_point start, int milliseconds)
+	{
+		return start + std::chrono::milliseconds(milliseconds);
+	}
+}
+
+TEST(FramePacerTest, testIdleWaitsForInput)
+{
+	//nothing to draw and nothing scheduled, the loop can sleep until there's input
+	FramePacer pacer(60.0);
+	const auto now = FramePacer::Clock::now();
+	EXPECT_TRUE(std::isinf(pacer.GetWaitSeconds(now, false, FramePacer::NoDeadline())));
+}
+
+TEST(FramePacerTest, testWaitForDeadline)
+{
+	FramePacer pacer(60.0);
+	const auto now = FramePacer::Clock::now();
+	EXPECT_NEAR(0.25, pacer.GetWaitSeconds(now, false, AfterMilliseconds(now, 250)), 1e-6);
+
+	//a deadline that has already passed doesn't wait at all
+	EXPECT_EQ(0.0, pacer.GetWaitSeconds(now, false, AfterMilliseconds(now, -5)));
+}
+
+TEST(FramePacerTest, testFrameCap)
+{
+	FramePacer pacer(50.0);
+	const auto start = FramePacer::Clock::now();
+
+	//the first frame can go right away
+	EXPECT_TRUE(pacer.CanDrawFrame(start));
+	EXPECT_EQ(0.0, pacer.GetWaitSeconds(start, true, FramePacer::NoDeadline()));
+	pacer.OnFrameDrawn(start);
+
+	//the next has to wait for its 20ms slot, unless a deadline comes first
+	const auto soon = AfterMilliseconds(start, 5);
+	EXPECT_FALSE(pacer.CanDrawFrame(soon));
+	EXPECT_NEAR(0.015, pacer.GetWaitSeconds(soon, true, FramePacer::NoDeadline()), 1e-6);
+	EXPECT_NEAR(0.005, pacer.GetWaitSeconds(soon, true, AfterMilliseconds(start, 10)), 1e-6);
+
+	EXPECT_TRUE(pacer.CanDrawFrame(AfterMilliseconds(start, 20)));
+}
+
+TEST(FramePacerTest, testUncapped)
+{
+	FramePacer pacer;
+	const auto start = FramePacer::Clock::now();
+	pacer.OnFrameDrawn(start);
+	EXPECT_TRUE(pacer.CanDrawFrame(start));
+	EXPECT_EQ(0.0, pacer.GetWaitSeconds(start, true, FramePacer::NoDeadline()));
+}
@@ -0,0 +1,96 @@
+#include "gtest\gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <numeric>
+
+#include "BoardController.h"
+#include "Commands.h"
+#include "GameSimulation.h"
+#include "PlayerController.h"
+#include "SimulationTestSettings.h"
+
+TEST(GameSimulationTest, testHarvestsBackToBack)
+{
+	//3 second harvests, each player starts one at 0, 3, ... 27 seconds
+	GameSimulation sim(MakeSimulationSettings(2, std::chrono::seconds(30), 1));
+	const auto start = sim.GetClock().Now();
+	const auto result = sim.PlayGame();
+
+	EXPECT_EQ(20, result.mNumHarvests);
+	EXPECT_TRUE(start + std::chrono::seconds(30) == sim.GetClock().Now());
+	//water tiles harvest nothing, everything else one resource
+	ASSERT_EQ(2u, result.mResourcesPerPlayer.size());
+	EXPECT_LE(result.mResourcesPerPlayer[0], 10);
+	EXPECT_LE(result.mResourcesPerPlayer[1], 10);
+	EXPECT_GT(result.mResourcesPerPlayer[0] + result.mResourcesPerPlayer[1], 0);
+}
+
+TEST(GameSimulationTest, testSameSeedSameGame)
+{
+	const auto settings = MakeSimulationSettings(6, std::chrono::minutes(10), 42);
+	GameSimulation simA(settings);
+	GameSimulation simB(settings);
+	const auto resultA = simA.PlayGame();
+	const auto resultB = simB.PlayGame();
+
+	EXPECT_EQ(resultA.mNumHarvests, resultB.mNumHarvests);
+	EXPECT_TRUE(resultA.mResourcesPerPlayer == resultB.mResourcesPerPlayer);
+
+	for (int playerID = 0; playerID < settings.mNumPlayers; ++playerID)
+		EXPECT_TRUE(simA.GetPlayerController().GetPlayerTiles(playerID) == simB.GetPlayerController().GetPlayerTiles(playerID));
+}
+
+TEST(GameSimulationTest, testCommandsWithoutRenderer)
+{
+	GameSimulation sim(MakeSimulationSettings(2, std::chrono::minutes(1), 3));
+	auto& pc = sim.GetPlayerController();
+	const auto tileID = *pc.GetPlayerTiles(1).begin();
+
+	//nothing on screen to move or pick from, these do nothing
+	PanCameraCommand pan(10.f, 0.f);
+	ZoomCameraCommand zoom(2.f);
+	PickSelectionCommand pick;
+	sim.SendCommand(pan);
+	sim.SendCommand(zoom);
+	sim.SendCommand(pick);
+
+	ChangePlayerCommand changePlayer(1);
+	SelectTileCommand selectTile(tileID);
+	HarvestCommand harvest;
+	sim.SendCommand(changePlayer);
+	sim.SendCommand(selectTile);
+	EXPECT_EQ(tileID, sim.GetBoardController().GetSelectedTileForPlayer(1));
+	sim.SendCommand(harvest);
+	EXPECT_TRUE(pc.IsPlayerTimerBusy(1));
+	EXPECT_FALSE(pc.IsPlayerTimerBusy(0));
+
+	//the clock only moves when asked, straight to the deadline
+	const auto start = sim.GetClock().Now();
+	EXPECT_FALSE(sim.RunToNextTimer(start + std::chrono::seconds(2)));
+	EXPECT_TRUE(start == sim.GetClock().Now());
+	EXPECT_TRUE(sim.RunToNextTimer(start + std::chrono::minutes(1)));
+	EXPECT_TRUE(start + std::chrono::seconds(3) == sim.GetClock().Now());
+	EXPECT_FALSE(pc.IsPlayerTimerBusy(1));
+	EXPECT_EQ(sim.GetBoardController().GetHarvestRate(tileID), sim.GetNumResources(1));
+	EXPECT_FALSE(sim.RunToNextTimer(start + std::chrono::minutes(1)));
+}
+
+TEST(GameSimulationTest, DISABLED_benchmarkGamesPerSecond)
+{
+	for (auto gameLength : { std::chrono::minutes(1), std::chrono::minutes(10) })
+	{
+		const int numGames = 1000;
+		long long numHarvests = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (int game = 0; game < numGames; ++game)
+		{
+			GameSimulation sim(MakeSimulationSettings(6, gameLength, game));
+			numHarvests += sim.PlayGame().mNumHarvests;
+		}
+		const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+		std::cout << std::chrono::duration_cast<std::chrono::minutes>(gameLength).count() << " minute games: "
+			<< numGames / elapsed.count() << " games per second, " << numHarvests / numGames << " harvests per game" << std::endl;
+	}
+}
@@ -0,0 +1,185 @@
+#include "gtest\gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "Commands.h"
+#include "GameSimulation.h"
+#include "GameSnapshot.h"
+#include "PlayerController.h"
+#include "SimulationTestSettings.h"
+
+namespace
+{
+	//a 61 tile board dealt out to 6 players
+	SimulationSettings
+	MakeSmallBoardSettings(std::chrono::steady_clock::duration gameLength, std::uint64_t seed)
+	{
+		auto settings = MakeSimulationSettings(6, gameLength, seed);
+		settings.mNumTilesPerType = 10;
+		return settings;
+	}
+}
+
+TEST(GameSnapshotTest, testWriteAndRead)
+{
+	GameSnapshot snapshot;
+	const std::vector<int> values = { 3, 1, 4, 1, 5 };
+	{
+		SnapshotWriter writer(snapshot);
+		writer.Write(42);
+		writer.Write(2.5);
+		writer.WriteVector(values);
+		writer.WriteVector(std::vector<int>());
+	}
+
+	SnapshotReader reader(snapshot);
+	int intValue;
+	double doubleValue;
+	std::vector<int> readValues;
+	std::vector<int> emptyValues(3, 7);
+	reader.Read(intValue);
+	reader.Read(doubleValue);
+	reader.ReadVector(readValues);
+	EXPECT_FALSE(reader.IsAtEnd());
+	reader.ReadVector(emptyValues);
+	EXPECT_TRUE(reader.IsAtEnd());
+
+	EXPECT_EQ(42, intValue);
+	EXPECT_EQ(2.5, doubleValue);
+	EXPECT_TRUE(values == readValues);
+	EXPECT_TRUE(emptyValues.empty());
+}
+
+TEST(GameSnapshotTest, testPagesCopiedOnWrite)
+{
+	std::vector<std::uint8_t> column(10 * GameSnapshot::PAGE_SIZE + 100);
+	for (size_t i = 0; i < column.size(); ++i)
+		column[i] = static_cast<std::uint8_t>(i * 7);
+
+	GameSnapshot snapshot;
+	{
+		SnapshotWriter writer(snapshot);
+		writer.WritePages(column.data(), column.size());
+	}
+	EXPECT_EQ(11, snapshot.GetNumPages());
+
+	//a copy shares every page until one of them is saved over
+	const auto copy = snapshot;
+	EXPECT_EQ(11, snapshot.CountSharedPages(copy));
+
+	const auto changed = 3 * GameSnapshot::PAGE_SIZE + 17;
+	column[changed]++;
+	{
+		SnapshotWriter writer(snapshot);
+		writer.WritePages(column.data(), column.size());
+	}
+	EXPECT_EQ(10, snapshot.CountSharedPages(copy));
+
+	//and each still reads back what it was saved with
+	auto restored = column;
+	restored[changed] = 0;
+	SnapshotReader(copy).ReadPages(restored.data(), restored.size());
+	EXPECT_EQ(column[changed] - 1, restored[changed]);
+	SnapshotReader(snapshot).ReadPages(restored.data(), restored.size());
+	EXPECT_TRUE(column == restored);
+}
+
+TEST(GameSnapshotTest, testRestorePlaysTheSameGame)
+{
+	GameSimulation sim(MakeSmallBoardSettings(std::chrono::minutes(1), 5));
+	sim.PlayGame();
+
+	//mid game, timers are running and players have resources
+	GameSnapshot snapshot;
+	sim.SaveSnapshot(snapshot);
+	const auto savedTime = sim.GetClock().Now();
+	const auto firstRun = sim.PlayGame();
+
+	sim.RestoreSnapshot(snapshot);
+	EXPECT_TRUE(savedTime == sim.GetClock().Now());
+	const auto secondRun = sim.PlayGame();
+
+	EXPECT_EQ(firstRun.mNumHarvests, secondRun.mNumHarvests);
+	EXPECT_TRUE(firstRun.mResourcesPerPlayer == secondRun.mResourcesPerPlayer);
+
+	//the same as a game that was never rolled back
+	GameSimulation straight(MakeSmallBoardSettings(std::chrono::minutes(1), 5));
+	straight.PlayGame();
+	const auto straightRun = straight.PlayGame();
+	EXPECT_EQ(straightRun.mNumHarvests, secondRun.mNumHarvests);
+	EXPECT_TRUE(straightRun.mResourcesPerPlayer == secondRun.mResourcesPerPlayer);
+}
+
+TEST(GameSnapshotTest, testWhatIfPreview)
+{
+	GameSimulation sim(MakeSmallBoardSettings(std::chrono::seconds(10), 9));
+	sim.PlayGame();
+	const auto resourcesBefore = sim.GetNumResources(2);
+
+	GameSnapshot snapshot;
+	sim.SaveSnapshot(snapshot);
+
+	//try a move and let it play out
+	ChangePlayerCommand changePlayer(2);
+	sim.SendCommand(changePlayer);
+	sim.GetClock().AdvanceBy(std::chrono::seconds(30));
+	sim.RunToNextTimer(sim.GetClock().Now());
+	EXPECT_FALSE(sim.GetPlayerController().IsPlayerTimerBusy(2));
+
+	sim.RestoreSnapshot(snapshot);
+	EXPECT_EQ(resourcesBefore, sim.GetNumResources(2));
+	EXPECT_TRUE(sim.GetPlayerController().IsPlayerTimerBusy(2));
+}
+
+TEST(GameSnapshotTest, testRestoreIntoAnotherGame)
+{
+	//both games deal every player the same number of tiles, so each player has
+	// changed as many times in one as in the other but holds different tiles
+	GameSimulation source(MakeSmallBoardSettings(std::chrono::minutes(1), 3));
+	GameSimulation target(MakeSmallBoardSettings(std::chrono::minutes(1), 4));
+
+	GameSnapshot snapshot;
+	source.SaveSnapshot(snapshot);
+	target.RestoreSnapshot(snapshot);
+
+	for (int playerID = 0; playerID < 6; ++playerID)
+	{
+		EXPECT_TRUE(source.GetPlayerController().GetPlayerTiles(playerID) == target.GetPlayerController().GetPlayerTiles(playerID));
+		EXPECT_EQ(source.GetNumResources(playerID), target.GetNumResources(playerID));
+	}
+}
+
+TEST(GameSnapshotTest, DISABLED_benchmarkSnapshotRestore)
+{
+	for (int minutes : { 1, 10 })
+	{
+		GameSimulation sim(MakeSmallBoardSettings(std::chrono::minutes(minutes), 1));
+		sim.PlayGame();
+
+		GameSnapshot snapshot;
+		const int numCycles = 10000;
+		auto start = std::chrono::steady_clock::now();
+		for (int cycle = 0; cycle < numCycles; ++cycle)
+		{
+			sim.SaveSnapshot(snapshot);
+			sim.RestoreSnapshot(snapshot);
+		}
+		const double unchangedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		//a step of lookahead: the next timer finishes, hands out its resources, then it's all put back
+		start = std::chrono::steady_clock::now();
+		for (int cycle = 0; cycle < numCycles; ++cycle)
+		{
+			sim.SaveSnapshot(snapshot);
+			sim.RunToNextTimer(std::chrono::steady_clock::time_point::max());
+			sim.RestoreSnapshot(snapshot);
+		}
+		const double lookaheadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << "after " << minutes << " minutes: " << snapshot.GetNumBytes() << " bytes, "
+			<< 1e6 * unchangedSeconds / numCycles << " us per save and restore, "
+			<< 1e6 * lookaheadSeconds / numCycles << " us per lookahead step" << std::endl;
+	}
+}
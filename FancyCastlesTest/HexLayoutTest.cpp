@@ -0,0 +1,46 @@
+#include "gtest\gtest.h"
+
+#include "Board.h"
+#include "HexLayout.h"
+
+TEST(HexLayoutTest, testPickTileCenters)
+{
+	Board b;
+	b.MakeBoard(6);
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+	{
+		const auto position = b.GetTileCoord(i);
+		float x, y;
+		HexLayout::GetCartesianFromAxial(x, y, position);
+		EXPECT_EQ(position, HexLayout::GetAxialFromCartesian(x, y));
+
+		//anywhere just inside the drawn hex picks the tile
+		for (const auto& direction : HexMath::DIRECTIONS)
+		{
+			float neighborX, neighborY;
+			HexLayout::GetCartesianFromAxial(neighborX, neighborY, position + direction);
+
+			AxialCoord picked;
+			EXPECT_TRUE(HexLayout::PickHex(x + 0.45f * (neighborX - x), y + 0.45f * (neighborY - y), picked));
+			EXPECT_EQ(position, picked);
+		}
+
+		//the corners are further out than the edges
+		AxialCoord picked;
+		EXPECT_TRUE(HexLayout::PickHex(x, y + 0.95f * HexLayout::HEX_SIZE, picked));
+		EXPECT_EQ(position, picked);
+		EXPECT_TRUE(HexLayout::PickHex(x - 0.8f * HexLayout::HEX_SIZE, y - 0.45f * HexLayout::HEX_SIZE, picked));
+		EXPECT_EQ(position, picked);
+	}
+}
+
+TEST(HexLayoutTest, testPickBorder)
+{
+	//halfway between two tiles is in the border, which doesn't belong to either
+	float x1, y1, x2, y2;
+	HexLayout::GetCartesianFromAxial(x1, y1, AxialCoord(0, 0));
+	HexLayout::GetCartesianFromAxial(x2, y2, AxialCoord(1, 0));
+
+	AxialCoord picked;
+	EXPECT_FALSE(HexLayout::PickHex((x1 + x2) / 2.f, (y1 + y2) / 2.f, picked));
+}
@@ -0,0 +1,119 @@
+#include "gtest\gtest.h"
+#include <unordered_set>
+
+#include "Board.h"
+#include "HexMath.h"
+
+//the whole library has to be usable at compile time
+static_assert(HexMath::Distance(AxialCoord(0, 0), AxialCoord(2, -1)) == 2, "distance should fold at compile time");
+static_assert(HexMath::HexCount(4) == 61, "a radius 4 board has 61 tiles");
+static_assert(HexMath::Neighbor(AxialCoord(1, 1), 7) == AxialCoord(0, 2), "directions wrap around");
+static_assert(HexMath::Rotate(AxialCoord(2, -1), 6) == AxialCoord(2, -1), "six turns is a full circle");
+static_assert(HexMath::SpiralCoord(AxialCoord(), 7) == HexMath::RingCoord(AxialCoord(), 2, 0), "spiral moves on to ring 2 after 7 hexes");
+
+TEST(HexMathTest, testCubeRoundTrip)
+{
+	for (int r = -3; r <= 3; ++r)
+	{
+		for (int q = -3; q <= 3; ++q)
+		{
+			const AxialCoord coord(r, q);
+			const auto cube = HexMath::ToCube(coord);
+			EXPECT_EQ(0, cube.x + cube.y + cube.z);
+			EXPECT_EQ(coord, HexMath::ToAxial(cube));
+		}
+	}
+}
+
+TEST(HexMathTest, testDistance)
+{
+	EXPECT_EQ(0, HexMath::Distance(AxialCoord(1, 2), AxialCoord(1, 2)));
+	for (const auto& direction : HexMath::DIRECTIONS)
+	{
+		EXPECT_EQ(1, HexMath::Length(direction));
+		EXPECT_EQ(3, HexMath::Distance(AxialCoord(), direction * 3));
+	}
+
+	EXPECT_EQ(4, HexMath::Distance(AxialCoord(-2, -1), AxialCoord(1, 0)));
+	EXPECT_EQ(HexMath::Distance(AxialCoord(5, -3), AxialCoord(-1, 2)), HexMath::Distance(AxialCoord(-1, 2), AxialCoord(5, -3)));
+}
+
+TEST(HexMathTest, testRotation)
+{
+	for (int direction = 0; direction < HexMath::NUM_DIRECTIONS; ++direction)
+	{
+		EXPECT_EQ(HexMath::Direction(direction + 1), HexMath::RotateRight(HexMath::Direction(direction)));
+		EXPECT_EQ(HexMath::Direction(direction - 1), HexMath::RotateLeft(HexMath::Direction(direction)));
+	}
+
+	const AxialCoord coord(3, -1);
+	const AxialCoord center(1, 1);
+	EXPECT_EQ(coord, HexMath::RotateLeft(HexMath::RotateRight(coord)));
+	EXPECT_EQ(HexMath::Rotate(coord, -2), HexMath::Rotate(coord, 4));
+	EXPECT_EQ(HexMath::Distance(coord, center), HexMath::Distance(HexMath::RotateAround(coord, center, 1), center));
+	EXPECT_EQ(center, HexMath::RotateAround(center, center, 3));
+}
+
+TEST(HexMathTest, testReflection)
+{
+	const AxialCoord coord(2, -3);
+	EXPECT_EQ(coord, HexMath::ReflectQ(HexMath::ReflectQ(coord)));
+	EXPECT_EQ(coord, HexMath::ReflectR(HexMath::ReflectR(coord)));
+	EXPECT_EQ(coord, HexMath::ReflectS(HexMath::ReflectS(coord)));
+	EXPECT_EQ(coord.q, HexMath::ReflectQ(coord).q);
+	EXPECT_EQ(coord.r, HexMath::ReflectR(coord).r);
+	EXPECT_EQ(HexMath::Length(coord), HexMath::Length(HexMath::ReflectS(coord)));
+}
+
+TEST(HexMathTest, testRingsAndSpiral)
+{
+	const AxialCoord center(1, -2);
+	for (int radius = 0; radius < 5; ++radius)
+	{
+		std::unordered_set<AxialCoord> ring;
+		for (int i = 0; i < HexMath::RingSize(radius); ++i)
+		{
+			const auto coord = HexMath::RingCoord(center, radius, i);
+			EXPECT_EQ(radius, HexMath::Distance(coord, center));
+			ring.insert(coord);
+
+			//consecutive hexes on the ring are neighbors
+			if (radius > 0)
+			{
+				EXPECT_EQ(1, HexMath::Distance(coord, HexMath::RingCoord(center, radius, (i + 1) % HexMath::RingSize(radius))));
+			}
+		}
+		EXPECT_EQ(HexMath::RingSize(radius), static_cast<int>(ring.size()));
+	}
+
+	std::unordered_set<AxialCoord> spiral;
+	for (int i = 0; i < HexMath::HexCount(4); ++i)
+	{
+		const auto coord = HexMath::SpiralCoord(center, i);
+		EXPECT_TRUE(HexMath::Distance(coord, center) <= 4);
+		spiral.insert(coord);
+	}
+	EXPECT_EQ(HexMath::HexCount(4), static_cast<int>(spiral.size()));
+}
+
+TEST(HexMathTest, testLine)
+{
+	const AxialCoord a(-3, 1);
+	const AxialCoord b(2, 2);
+	const auto lineSize = HexMath::LineSize(a, b);
+	EXPECT_EQ(HexMath::Distance(a, b) + 1, lineSize);
+	EXPECT_EQ(a, HexMath::LineCoord(a, b, 0));
+	EXPECT_EQ(b, HexMath::LineCoord(a, b, lineSize - 1));
+	for (int i = 1; i < lineSize; ++i)
+		EXPECT_EQ(1, HexMath::Distance(HexMath::LineCoord(a, b, i - 1), HexMath::LineCoord(a, b, i)));
+
+	EXPECT_EQ(a, HexMath::LineCoord(a, a, 0));
+}
+
+TEST(HexMathTest, testSpiralMatchesBoard)
+{
+	Board b;
+	b.MakeBoard(12, 1, TileOrdering::SPIRAL);
+	for (int i = 0; i < b.GetNumTiles(); ++i)
+		EXPECT_EQ(HexMath::SpiralCoord(AxialCoord(), i), b.GetTileCoord(i));
+}
@@ -0,0 +1,140 @@
+#include "gtest\gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "GameSimulation.h"
+#include "MatchRunner.h"
+
+namespace
+{
+	MatchList
+	MakeMatches(int numMatches, std::chrono::steady_clock::duration gameLength)
+	{
+		SimulationSettings base;
+		base.mGameLength = gameLength;
+		MatchSweep sweep;
+		sweep.mNumPlayers = { 2, 4, 6 };
+		sweep.mGamesPerSetting = numMatches / 3;
+		return MatchRunner::MakeSweep(base, sweep);
+	}
+
+	bool
+	SameResults(const MatchResultList& a, const MatchResultList& b)
+	{
+		if (a.size() != b.size())
+			return false;
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			if (a[i].mNumHarvests != b[i].mNumHarvests || a[i].mResourcesPerPlayer != b[i].mResourcesPerPlayer)
+				return false;
+		}
+		return true;
+	}
+}
+
+TEST(MatchRunnerTest, testMakeSweep)
+{
+	SimulationSettings base;
+	base.mSeed = 100;
+	MatchSweep sweep;
+	sweep.mNumPlayers = { 2, 3 };
+	sweep.mNumStartingBills = { 0, 5, 10 };
+	sweep.mGamesPerSetting = 4;
+	const auto matches = MatchRunner::MakeSweep(base, sweep);
+
+	ASSERT_EQ(24u, matches.size());
+	//settings not in the sweep come from the base
+	for (const auto& match : matches)
+	{
+		EXPECT_EQ(base.mNumTilesPerType, match.mNumTilesPerType);
+		EXPECT_EQ(base.mHarvestRateBonus, match.mHarvestRateBonus);
+	}
+	EXPECT_EQ(2, matches.front().mNumPlayers);
+	EXPECT_EQ(0, matches.front().mNumStartingBills);
+	EXPECT_EQ(100u, matches.front().mSeed);
+	EXPECT_EQ(3, matches.back().mNumPlayers);
+	EXPECT_EQ(10, matches.back().mNumStartingBills);
+	EXPECT_EQ(103u, matches.back().mSeed);
+}
+
+TEST(MatchRunnerTest, testSameResultsOnAnyThreadCount)
+{
+	const auto matches = MakeMatches(30, std::chrono::minutes(2));
+	const auto serial = MatchRunner(1).Run(matches);
+	ASSERT_EQ(matches.size(), serial.size());
+
+	//more threads than matches too
+	for (int numThreads : { 2, 3, 8, 64 })
+		EXPECT_TRUE(SameResults(serial, MatchRunner(numThreads).Run(matches)));
+
+	//and each one is the game the settings give on their own
+	for (size_t match = 0; match < matches.size(); match += 7)
+	{
+		GameSimulation sim(matches[match]);
+		const auto result = sim.PlayGame();
+		EXPECT_EQ(result.mNumHarvests, serial[match].mNumHarvests);
+		EXPECT_TRUE(result.mResourcesPerPlayer == serial[match].mResourcesPerPlayer);
+	}
+}
+
+TEST(MatchRunnerTest, testHarvestRateBonus)
+{
+	SimulationSettings settings;
+	settings.mGameLength = std::chrono::minutes(2);
+	const auto normal = MatchRunner(1).Run(MatchList(1, settings));
+	settings.mHarvestRateBonus = 2;
+	const auto boosted = MatchRunner(1).Run(MatchList(1, settings));
+
+	//same choices, every harvest that gave anything gives two more
+	EXPECT_EQ(normal[0].mNumHarvests, boosted[0].mNumHarvests);
+	for (size_t player = 0; player < normal[0].mResourcesPerPlayer.size(); ++player)
+		EXPECT_EQ(normal[0].mResourcesPerPlayer[player] * 3, boosted[0].mResourcesPerPlayer[player]);
+}
+
+TEST(MatchRunnerTest, testWriteCsv)
+{
+	MatchList matches(2);
+	matches[1].mSeed = 7;
+	matches[1].mGameLength = std::chrono::seconds(90);
+	MatchResultList results(2);
+	results[0].mNumHarvests = 3;
+	results[0].mResourcesPerPlayer = { 1, 4, 2 };
+	results[1].mNumHarvests = 5;
+
+	std::ostringstream out;
+	MatchRunner::WriteCsv(out, matches, results);
+
+	std::istringstream lines(out.str());
+	std::string header, first, second, extra;
+	std::getline(lines, header);
+	std::getline(lines, first);
+	std::getline(lines, second);
+	EXPECT_FALSE(std::getline(lines, extra));
+
+	EXPECT_EQ(0u, header.find("match,seed,players,"));
+	EXPECT_EQ("0,1,6,20,10,5,0,600,3,7,1,4", first);
+	EXPECT_EQ("1,7,6,20,10,5,0,90,5,0,0,0", second);
+}
+
+TEST(MatchRunnerTest, DISABLED_benchmarkMatchesPerSecond)
+{
+	const auto matches = MakeMatches(600, std::chrono::minutes(10));
+
+	double serialSeconds = 0.0;
+	for (int numThreads : { 1, 0 })
+	{
+		const MatchRunner runner(numThreads);
+		const auto start = std::chrono::steady_clock::now();
+		const auto results = runner.Run(matches);
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (numThreads == 1)
+			serialSeconds = seconds;
+
+		std::cout << runner.GetNumThreads() << " threads: " << matches.size() / seconds << " matches per second, "
+			<< serialSeconds / seconds << "x" << std::endl;
+		EXPECT_EQ(matches.size(), results.size());
+	}
+}
@@ -0,0 +1,160 @@
+#include "gtest\gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "ProgramCache.h"
+
+namespace
+{
+	std::string
+	GetTempDirectory()
+	{
+#ifdef _WIN32
+		char* temp = nullptr;
+		size_t size = 0;
+		std::string directory = ".";
+		if (_dupenv_s(&temp, &size, "TEMP") == 0 && temp != nullptr)
+			directory = temp;
+		free(temp);
+		return directory;
+#else
+		const char* temp = std::getenv("TMPDIR");
+		return temp != nullptr && *temp != '\0' ? temp : "/tmp";
+#endif
+	}
+
+	std::vector<char>
+	MakeBinary(size_t size)
+	{
+		std::vector<char> binary(size);
+		for (size_t i = 0; i < size; ++i)
+			binary[i] = static_cast<char>(i * 31 + 7);
+		return binary;
+	}
+}
+
+//each test gets a cache in the temp directory, emptied and removed afterwards
+class ProgramCacheTest : public ::testing::Test
+{
+protected:
+	ProgramCacheTest()
+		: mDirectory(GetTempDirectory() + "/fancycastles_programcachetest")
+		, mCache(mDirectory)
+	{
+	}
+
+	void TearDown() override
+	{
+		for (auto key : mKeys)
+			std::remove(mCache.GetPath(key).c_str());
+#ifdef _WIN32
+		_rmdir(mDirectory.c_str());
+#else
+		rmdir(mDirectory.c_str());
+#endif
+	}
+
+	//a key with no file yet, its file is removed after the test
+	std::uint64_t MakeKey(const std::vector<std::string>& parts)
+	{
+		const auto key = ProgramCache::HashParts(parts);
+		mKeys.push_back(key);
+		std::remove(mCache.GetPath(key).c_str());
+		return key;
+	}
+
+	std::string mDirectory;
+	ProgramCache mCache;
+	std::vector<std::uint64_t> mKeys;
+};
+
+TEST_F(ProgramCacheTest, testHashParts)
+{
+	const auto hash = ProgramCache::HashParts({ "vert", "frag", "outColor" });
+	EXPECT_EQ(hash, ProgramCache::HashParts({ "vert", "frag", "outColor" }));
+	EXPECT_NE(hash, ProgramCache::HashParts({ "vert", "frag", "pickID" }));
+
+	//the same text split differently is a different program
+	EXPECT_NE(ProgramCache::HashParts({ "ab", "c" }), ProgramCache::HashParts({ "a", "bc" }));
+	EXPECT_NE(ProgramCache::HashParts({ "a", "" }), ProgramCache::HashParts({ "a" }));
+}
+
+TEST_F(ProgramCacheTest, testStoreAndLoad)
+{
+	EXPECT_TRUE(mCache.IsEnabled());
+
+	const auto key = MakeKey({ "testStoreAndLoad" });
+
+	std::uint32_t format = 0;
+	std::vector<char> binary;
+	EXPECT_FALSE(mCache.Load(key, format, binary));
+
+	const auto stored = MakeBinary(1000);
+	EXPECT_TRUE(mCache.Store(key, 0x8741, stored));
+	EXPECT_TRUE(mCache.Load(key, format, binary));
+	EXPECT_EQ(0x8741u, format);
+	EXPECT_TRUE(stored == binary);
+
+	//storing again replaces it
+	const auto restored = MakeBinary(10);
+	EXPECT_TRUE(mCache.Store(key, 1, restored));
+	EXPECT_TRUE(mCache.Load(key, format, binary));
+	EXPECT_EQ(1u, format);
+	EXPECT_TRUE(restored == binary);
+}
+
+TEST_F(ProgramCacheTest, testBadFilesAreIgnored)
+{
+	const auto key = MakeKey({ "testBadFilesAreIgnored" });
+	const auto otherKey = MakeKey({ "testBadFilesAreIgnored", "other" });
+	EXPECT_TRUE(mCache.Store(key, 1, MakeBinary(100)));
+
+	std::uint32_t format = 0;
+	std::vector<char> binary;
+
+	//a file copied over from another key
+	EXPECT_EQ(0, std::rename(mCache.GetPath(key).c_str(), mCache.GetPath(otherKey).c_str()));
+	EXPECT_FALSE(mCache.Load(otherKey, format, binary));
+	std::remove(mCache.GetPath(otherKey).c_str());
+
+	//cut short
+	EXPECT_TRUE(mCache.Store(key, 1, MakeBinary(100)));
+	{
+		std::ifstream in(mCache.GetPath(key), std::ios::binary);
+		std::vector<char> contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		in.close();
+		contents.resize(contents.size() - 1);
+		std::ofstream out(mCache.GetPath(key), std::ios::binary | std::ios::trunc);
+		out.write(contents.data(), contents.size());
+	}
+	EXPECT_FALSE(mCache.Load(key, format, binary));
+
+	//not a cache file at all
+	{
+		std::ofstream out(mCache.GetPath(key), std::ios::binary | std::ios::trunc);
+		out << "#version 330";
+	}
+	EXPECT_FALSE(mCache.Load(key, format, binary));
+}
+
+TEST_F(ProgramCacheTest, testDisabled)
+{
+	ProgramCache cache("");
+	EXPECT_FALSE(cache.IsEnabled());
+
+	std::uint32_t format = 0;
+	std::vector<char> binary;
+	EXPECT_FALSE(cache.Store(1, 1, MakeBinary(10)));
+	EXPECT_FALSE(cache.Load(1, format, binary));
+}
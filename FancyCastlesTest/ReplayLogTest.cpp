@@ -0,0 +1,240 @@
+#include "gtest\gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "BoardController.h"
+#include "GameSimulation.h"
+#include "ReplayLog.h"
+#include "SimulationTestSettings.h"
+
+namespace
+{
+	ReplayEvent
+	MakeEvent(ReplayEventType type, long long microseconds)
+	{
+		ReplayEvent event;
+		event.mType = type;
+		event.mTime = std::chrono::microseconds(microseconds);
+		return event;
+	}
+
+	ReplayBytes
+	RecordGame(const SimulationSettings& settings, SimulationResult& result)
+	{
+		std::ostringstream out;
+		{
+			ReplayWriter writer(out);
+			GameSimulation sim(settings);
+			sim.StartRecording(writer);
+			result = sim.PlayGame();
+		}
+		const auto bytes = out.str();
+		return ReplayBytes(bytes.begin(), bytes.end());
+	}
+}
+
+TEST(ReplayLogTest, testVarints)
+{
+	const std::uint64_t values[] = { 0, 1, 127, 128, 300, 16383, 16384, 0xffffffffull, std::numeric_limits<std::uint64_t>::max() };
+	const size_t sizes[] = { 1, 1, 1, 2, 2, 2, 3, 5, 10 };
+
+	for (int i = 0; i < 9; ++i)
+	{
+		ReplayBytes bytes;
+		ReplayLog::WriteVarint(bytes, values[i]);
+		EXPECT_EQ(sizes[i], bytes.size());
+
+		const std::uint8_t* pos = bytes.data();
+		std::uint64_t value;
+		EXPECT_TRUE(ReplayLog::ReadVarint(pos, bytes.data() + bytes.size(), value));
+		EXPECT_EQ(values[i], value);
+		EXPECT_EQ(bytes.data() + bytes.size(), pos);
+
+		//one byte short
+		pos = bytes.data();
+		EXPECT_FALSE(ReplayLog::ReadVarint(pos, bytes.data() + bytes.size() - 1, value));
+	}
+
+	//small numbers either side of zero stay small
+	EXPECT_EQ(0u, ReplayLog::ZigZag(0));
+	EXPECT_EQ(1u, ReplayLog::ZigZag(-1));
+	EXPECT_EQ(2u, ReplayLog::ZigZag(1));
+	for (std::int64_t value : { std::int64_t(0), std::int64_t(-1), std::int64_t(63), std::int64_t(-64),
+		std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max() })
+		EXPECT_EQ(value, ReplayLog::UnZigZag(ReplayLog::ZigZag(value)));
+}
+
+TEST(ReplayLogTest, testWriteAndRead)
+{
+	ReplayHeader header;
+	header.mSeed = 0x0123456789abcdefull;
+	header.mNumTilesPerType = 20;
+	header.mNumPlayers = 4;
+	header.mNumStartingBills = 5;
+	header.mHarvestRateBonus = -1;
+
+	ReplayEventList events;
+	events.push_back(MakeEvent(ReplayEventType::TILE_ASSIGNED, 0));
+	events.back().mTileID = 12;
+	events.back().mPlayerID = 3;
+	events.push_back(MakeEvent(ReplayEventType::MOVE_SELECTION, 1500));
+	events.back().mOffset = AxialCoord(-1, 1);
+	events.push_back(MakeEvent(ReplayEventType::PAN_CAMERA, 1500));
+	events.back().mX = -12.5f;
+	events.back().mY = 0.25f;
+	events.push_back(MakeEvent(ReplayEventType::HARVEST, 2000000));
+	events.push_back(MakeEvent(ReplayEventType::TIMER_FINISHED, 5000001));
+	events.back().mPlayerID = 3;
+	events.back().mTileID = 12;
+	events.back().mQuantity = 2;
+	events.back().mObjectType = GameObjectType::RESOURCE;
+
+	ReplayBytes bytes;
+	ReplayLog::WriteHeader(bytes, header);
+	const auto headerSize = bytes.size();
+	std::chrono::microseconds previousTime(0);
+	for (const auto& event : events)
+	{
+		ReplayLog::WriteEvent(bytes, event, previousTime);
+		previousTime = event.mTime;
+	}
+	//a few bytes an event
+	EXPECT_GT(48u, bytes.size() - headerSize);
+
+	ReplayHeader readHeader;
+	ReplayEventList readEvents;
+	ASSERT_TRUE(ReplayLog::Read(bytes, readHeader, readEvents));
+	EXPECT_EQ(header.mSeed, readHeader.mSeed);
+	EXPECT_EQ(20, readHeader.mNumTilesPerType);
+	EXPECT_EQ(4, readHeader.mNumPlayers);
+	EXPECT_EQ(5, readHeader.mNumStartingBills);
+	EXPECT_EQ(-1, readHeader.mHarvestRateBonus);
+
+	ASSERT_EQ(events.size(), readEvents.size());
+	for (size_t i = 0; i < events.size(); ++i)
+	{
+		EXPECT_TRUE(events[i].mType == readEvents[i].mType);
+		EXPECT_EQ(events[i].mTime.count(), readEvents[i].mTime.count());
+		EXPECT_EQ(events[i].mPlayerID, readEvents[i].mPlayerID);
+		EXPECT_EQ(events[i].mTileID, readEvents[i].mTileID);
+		EXPECT_TRUE(events[i].mOffset == readEvents[i].mOffset);
+		EXPECT_EQ(events[i].mX, readEvents[i].mX);
+		EXPECT_EQ(events[i].mY, readEvents[i].mY);
+		EXPECT_EQ(events[i].mQuantity, readEvents[i].mQuantity);
+		EXPECT_TRUE(events[i].mObjectType == readEvents[i].mObjectType);
+	}
+
+	//cut short, the whole events before the cut are kept
+	bytes.pop_back();
+	EXPECT_FALSE(ReplayLog::Read(bytes, readHeader, readEvents));
+	EXPECT_EQ(events.size() - 1, readEvents.size());
+
+	bytes[0] = 'X';
+	EXPECT_FALSE(ReplayLog::Read(bytes, readHeader, readEvents));
+}
+
+TEST(ReplayLogTest, testWriterKeepsOrder)
+{
+	std::ostringstream out;
+	std::string expected;
+	{
+		ReplayWriter writer(out);
+		for (int i = 0; i < 1000; ++i)
+		{
+			const ReplayBytes bytes(i % 7 + 1, static_cast<std::uint8_t>('a' + i % 26));
+			writer.Append(bytes);
+			expected.append(bytes.begin(), bytes.end());
+			if (i % 100 == 0)
+			{
+				writer.Flush();
+				EXPECT_EQ(expected, out.str());
+			}
+		}
+	}
+	EXPECT_EQ(expected, out.str());
+}
+
+TEST(ReplayLogTest, testReplayMatchesRecording)
+{
+	SimulationResult recorded;
+	const auto bytes = RecordGame(MakeSimulationSettings(6, std::chrono::minutes(5), 7), recorded);
+
+	ReplayHeader header;
+	ReplayEventList events;
+	ASSERT_TRUE(ReplayLog::Read(bytes, header, events));
+	EXPECT_EQ(7u, header.mSeed);
+	EXPECT_EQ(6, header.mNumPlayers);
+
+	const auto replayed = ReplayLog::Play(header, events);
+	//change player, select tile and harvest for each
+	EXPECT_EQ(3 * recorded.mNumHarvests, replayed.mNumCommands);
+	EXPECT_GT(replayed.mNumTimersRecorded, 0);
+	EXPECT_EQ(replayed.mNumTimersRecorded, replayed.mNumTimersFinished);
+	EXPECT_EQ(0, replayed.mNumTimerMismatches);
+	EXPECT_TRUE(recorded.mResourcesPerPlayer == replayed.mResourcesPerPlayer);
+}
+
+TEST(ReplayLogTest, testReplayFinishesLateTimers)
+{
+	//a real game logs the harvest a moment before its timer starts, so the
+	// timer can be logged as finished a hair before the replay's deadline
+	ReplayHeader header;
+	header.mSeed = 3;
+	header.mNumTilesPerType = 20;
+	header.mNumPlayers = 2;
+	header.mNumStartingBills = 5;
+
+	ReplayEventList events;
+	events.push_back(MakeEvent(ReplayEventType::TILE_ASSIGNED, 0));
+	events.back().mTileID = 0;
+	events.back().mPlayerID = 1;
+	events.push_back(MakeEvent(ReplayEventType::CHANGE_PLAYER, 10));
+	events.back().mPlayerID = 1;
+	events.push_back(MakeEvent(ReplayEventType::SELECT_TILE, 20));
+	events.back().mTileID = 0;
+	events.push_back(MakeEvent(ReplayEventType::HARVEST, 30));
+
+	//see what the harvest gives, then log it finishing early
+	auto replayed = ReplayLog::Play(header, events);
+	EXPECT_EQ(3, replayed.mNumCommands);
+	EXPECT_EQ(0, replayed.mNumTimersFinished);
+
+	SimulationSettings settings;
+	settings.mSeed = header.mSeed;
+	settings.mTilesPerPlayer = 0;
+	GameSimulation sim(settings);
+	events.push_back(MakeEvent(ReplayEventType::TIMER_FINISHED, 2999990));
+	events.back().mPlayerID = 1;
+	events.back().mTileID = 0;
+	events.back().mQuantity = sim.GetBoardController().GetHarvestRate(0);
+	events.back().mObjectType = GameObjectType::RESOURCE;
+
+	replayed = ReplayLog::Play(header, events);
+	EXPECT_EQ(1, replayed.mNumTimersRecorded);
+	EXPECT_EQ(1, replayed.mNumTimersFinished);
+	EXPECT_EQ(0, replayed.mNumTimerMismatches);
+	EXPECT_EQ(events.back().mQuantity, replayed.mResourcesPerPlayer[1]);
+}
+
+TEST(ReplayLogTest, DISABLED_benchmarkReplay)
+{
+	SimulationResult recorded;
+	const auto bytes = RecordGame(MakeSimulationSettings(6, std::chrono::minutes(60), 1), recorded);
+
+	ReplayHeader header;
+	ReplayEventList events;
+	ASSERT_TRUE(ReplayLog::Read(bytes, header, events));
+
+	const int numReplays = 20;
+	const auto start = std::chrono::steady_clock::now();
+	for (int replay = 0; replay < numReplays; ++replay)
+		EXPECT_EQ(0, ReplayLog::Play(header, events).mNumTimerMismatches);
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << events.size() << " events in " << bytes.size() << " bytes (" << static_cast<double>(bytes.size()) / events.size()
+		<< " per event), replayed at " << numReplays * events.size() / seconds << " events per second" << std::endl;
+}
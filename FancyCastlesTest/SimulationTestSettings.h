@@ -0,0 +1,17 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "GameSimulation.h"
+
+//settings for the simulation tests, the rest are SimulationSettings' defaults
+inline SimulationSettings
+MakeSimulationSettings(int numPlayers, std::chrono::steady_clock::duration gameLength, std::uint64_t seed)
+{
+	SimulationSettings settings;
+	settings.mNumPlayers = numPlayers;
+	settings.mGameLength = gameLength;
+	settings.mSeed = seed;
+	return settings;
+}
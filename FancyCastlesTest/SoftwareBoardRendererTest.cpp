@@ -0,0 +1,187 @@
+#include "gtest\gtest.h"
+
+#include <chrono>
+#include <climits>
+#include <iostream>
+
+#include "Board.h"
+#include "HexLayout.h"
+#include "SoftwareBoardRenderer.h"
+#include "TilePalette.h"
+
+namespace
+{
+	const int WIDTH = 683;
+	const int HEIGHT = 384;
+	const std::uint32_t BLACK = SoftwareBoardRenderer::PackColor(0.f, 0.f, 0.f);
+	const std::uint32_t WHITE = SoftwareBoardRenderer::PackColor(1.f, 1.f, 1.f);
+
+	std::uint32_t
+	GetTileColor(const Board& b, int tileID)
+	{
+		const auto color = TilePalette::GetColor(b.GetTileType(tileID));
+		return SoftwareBoardRenderer::PackColor(color.r, color.g, color.b);
+	}
+
+	//pixel under a world position, rows counted from the top
+	std::uint32_t
+	GetWorldPixel(SoftwareBoardRenderer& renderer, float x, float y)
+	{
+		float windowX, windowY;
+		renderer.GetCamera().WorldToWindow(windowX, windowY, x, y);
+		return renderer.GetPixel(static_cast<int>(windowX), renderer.GetHeight() - 1 - static_cast<int>(windowY));
+	}
+}
+
+TEST(SoftwareBoardRendererTest, testTileCenterHasTileColor)
+{
+	Board b;
+	b.MakeBoard(6);
+	SoftwareBoardRenderer renderer(WIDTH, HEIGHT);
+	renderer.SetupTiles(b);
+	EXPECT_TRUE(renderer.NeedsRedraw());
+
+	renderer.RenderScene();
+	EXPECT_FALSE(renderer.NeedsRedraw());
+	EXPECT_EQ(1, renderer.GetNumFramesDrawn());
+
+	for (int tileID = 0; tileID < b.GetNumTiles(); ++tileID)
+	{
+		float x, y;
+		HexLayout::GetCartesianFromAxial(x, y, b.GetTileCoord(tileID));
+		EXPECT_EQ(GetTileColor(b, tileID), GetWorldPixel(renderer, x, y));
+	}
+}
+
+TEST(SoftwareBoardRendererTest, testBorderBetweenTilesIsBackground)
+{
+	Board b;
+	b.MakeBoard(6);
+	SoftwareBoardRenderer renderer(WIDTH, HEIGHT);
+	renderer.SetupTiles(b);
+	renderer.GetCamera().SetZoom(4.f);
+	renderer.RenderScene();
+
+	//halfway between the center tile and its neighbor in +r
+	EXPECT_EQ(BLACK, GetWorldPixel(renderer, HexLayout::HEX_WIDTH / 2.f, 0.f));
+	EXPECT_NE(BLACK, GetWorldPixel(renderer, HexLayout::HEX_WIDTH / 2.f - 0.05f, 0.f));
+	EXPECT_NE(BLACK, GetWorldPixel(renderer, HexLayout::HEX_WIDTH / 2.f + 0.05f, 0.f));
+}
+
+TEST(SoftwareBoardRendererTest, testSelectionOutline)
+{
+	Board b;
+	b.MakeBoard(6);
+	SoftwareBoardRenderer renderer(WIDTH, HEIGHT);
+	renderer.SetupTiles(b);
+	renderer.GetCamera().SetZoom(4.f);
+	renderer.SetSelection(AxialCoord(0, 0));
+	EXPECT_TRUE(renderer.NeedsRedraw());
+	renderer.RenderScene();
+
+	const auto centerTile = b.GetTileIndex(AxialCoord(0, 0));
+	EXPECT_EQ(GetTileColor(b, centerTile), GetWorldPixel(renderer, 0.f, 0.f));
+	EXPECT_EQ(WHITE, GetWorldPixel(renderer, 0.8f, 0.f));
+	EXPECT_EQ(WHITE, GetWorldPixel(renderer, 0.f, -0.9f));
+
+	//off the board clears it
+	renderer.SetSelection(AxialCoord(1000, 0));
+	renderer.RenderScene();
+	EXPECT_EQ(GetTileColor(b, centerTile), GetWorldPixel(renderer, 0.8f, 0.f));
+}
+
+TEST(SoftwareBoardRendererTest, testSetTileType)
+{
+	Board b;
+	b.MakeBoard(6);
+	SoftwareBoardRenderer renderer(WIDTH, HEIGHT);
+	renderer.SetupTiles(b);
+	renderer.RenderScene();
+
+	const auto centerTile = b.GetTileIndex(AxialCoord(0, 0));
+	const auto newType = b.GetTileType(centerTile) == ResourceType::WATER ? ResourceType::ORE : ResourceType::WATER;
+	renderer.SetTileType(centerTile, newType);
+	EXPECT_TRUE(renderer.NeedsRedraw());
+
+	renderer.RunFrame(FramePacer::NoDeadline());
+	EXPECT_EQ(2, renderer.GetNumFramesDrawn());
+	const auto color = TilePalette::GetColor(newType);
+	EXPECT_EQ(SoftwareBoardRenderer::PackColor(color.r, color.g, color.b), GetWorldPixel(renderer, 0.f, 0.f));
+
+	//nothing changed, nothing drawn
+	renderer.RunFrame(FramePacer::NoDeadline());
+	EXPECT_EQ(2, renderer.GetNumFramesDrawn());
+}
+
+TEST(SoftwareBoardRendererTest, testPickMatchesPixels)
+{
+	Board b;
+	b.MakeBoard(6);
+	SoftwareBoardRenderer renderer(WIDTH, HEIGHT);
+	renderer.SetupTiles(b);
+	renderer.GetCamera().SetZoom(2.f);
+	renderer.GetCamera().SetCenter(1.3f, -0.4f);
+	renderer.RenderScene();
+
+	//a pixel is drawn exactly when its center picks a tile, and in that tile's color
+	int numPicked = 0;
+	for (int row = 0; row < HEIGHT; ++row)
+	{
+		for (int column = 0; column < WIDTH; ++column)
+		{
+			const auto pickedTile = renderer.PickTile(column + 0.5, HEIGHT - row - 0.5);
+			const auto pixel = renderer.GetPixel(column, row);
+			if (pickedTile == INT_MAX)
+			{
+				EXPECT_EQ(BLACK, pixel);
+			}
+			else
+			{
+				EXPECT_EQ(GetTileColor(b, pickedTile), pixel);
+				numPicked++;
+			}
+		}
+	}
+	EXPECT_GT(numPicked, 0);
+
+	renderer.SetMousePosition(WIDTH / 2.0, HEIGHT / 2.0);
+	EXPECT_EQ(renderer.PickTile(WIDTH / 2.0, HEIGHT / 2.0), renderer.DoPick());
+}
+
+TEST(SoftwareBoardRendererTest, testZoomedInDrawsFewerTiles)
+{
+	Board b;
+	b.MakeBoard(2000);
+	SoftwareBoardRenderer renderer(WIDTH, HEIGHT);
+	renderer.SetupTiles(b);
+
+	renderer.GetCamera().SetZoom(Camera::GetMinZoom());
+	renderer.RenderScene();
+	const auto zoomedOutTiles = renderer.GetLastDrawnTiles();
+	EXPECT_EQ(b.GetNumTiles(), zoomedOutTiles);
+
+	renderer.GetCamera().SetZoom(4.f);
+	renderer.RenderScene();
+	EXPECT_GT(renderer.GetLastDrawnTiles(), 0);
+	EXPECT_LT(renderer.GetLastDrawnTiles(), zoomedOutTiles);
+}
+
+TEST(SoftwareBoardRendererTest, DISABLED_benchmarkRenderScene)
+{
+	for (int numTilesPerType : { 6, 2000, 20000 })
+	{
+		Board b;
+		b.MakeBoard(numTilesPerType);
+		SoftwareBoardRenderer renderer(1366, 768);
+		renderer.SetupTiles(b);
+
+		const int numFrames = 100;
+		const auto start = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < numFrames; ++frame)
+			renderer.RenderScene();
+		const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+		std::cout << b.GetNumTiles() << " tiles, " << renderer.GetLastDrawnTiles() << " drawn: "
+			<< elapsed.count() / numFrames << " ms per frame" << std::endl;
+	}
+}
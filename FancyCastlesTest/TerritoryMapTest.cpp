@@ -0,0 +1,70 @@
+#include "gtest\gtest.h"
+#include <algorithm>
+#include <random>
+
+#include "BoardController.h"
+#include "BoardControllerTestSetup.h"
+#include "TerritoryMap.h"
+
+namespace
+{
+	void
+	ExpectMatchesSearch(const BoardController& bc, const TerritoryMap& territories, const TileIDSet& owned)
+	{
+		for (auto tileID : owned)
+		{
+			const auto expected = bc.FindConnectedComponent(owned, tileID);
+			const auto connected = territories.GetConnectedTiles(tileID);
+
+			EXPECT_EQ(expected, TileIDSet(connected.begin(), connected.end()));
+			EXPECT_EQ(static_cast<int>(expected.size()), territories.GetTerritorySize(tileID));
+			for (auto other : expected)
+				EXPECT_TRUE(territories.AreConnected(tileID, other));
+		}
+	}
+}
+
+TEST(TerritoryMapTest, testUnownedTiles)
+{
+	const auto bc = MakeController(6);
+	TerritoryMap territories(*bc);
+
+	EXPECT_FALSE(territories.OwnsTile(0));
+	EXPECT_EQ(-1, territories.GetTerritoryID(0));
+	EXPECT_TRUE(territories.GetConnectedTiles(0).empty());
+	EXPECT_FALSE(territories.AreConnected(0, 0));
+
+	territories.AddTile(0);
+	EXPECT_TRUE(territories.AreConnected(0, 0));
+	territories.RemoveTile(0);
+	EXPECT_EQ(0, territories.GetTerritorySize(0));
+}
+
+TEST(TerritoryMapTest, testAddAndRemoveTiles)
+{
+	std::mt19937 rng(2468);
+	const auto bc = MakeController(20);
+	const auto numTiles = bc->GetNumTiles();
+
+	TerritoryMap territories(*bc);
+	TileIDSet owned;
+	for (int step = 0; step < 300; ++step)
+	{
+		const int tileID = rng() % numTiles;
+		if (rng() % 3 == 0)
+		{
+			territories.RemoveTile(tileID);
+			owned.erase(tileID);
+		}
+		else
+		{
+			territories.AddTile(tileID);
+			owned.insert(tileID);
+		}
+
+		if (step % 10 == 0)
+			ExpectMatchesSearch(*bc, territories, owned);
+	}
+
+	ExpectMatchesSearch(*bc, territories, owned);
+}
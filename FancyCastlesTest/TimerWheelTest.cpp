@@ -0,0 +1,224 @@
+#include "gtest\gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+
+#include "GameSnapshot.h"
+#include "TimerWheel.h"
+
+namespace
+{
+	using Clock = TimerWheel::Clock;
+	using std::chrono::milliseconds;
+
+	const Clock::time_point START = Clock::time_point() + std::chrono::hours(1);
+}
+
+TEST(TimerWheelTest, testFiresAtDeadline)
+{
+	TimerWheel wheel(START);
+	std::vector<int> expired;
+
+	wheel.Schedule(7, START + milliseconds(3000));
+	EXPECT_TRUE(wheel.IsScheduled(7));
+	EXPECT_EQ(1, wheel.GetNumScheduled());
+	EXPECT_TRUE(START + milliseconds(3000) == wheel.GetNextDeadline());
+
+	wheel.Advance(START + milliseconds(2999), expired);
+	EXPECT_TRUE(expired.empty());
+
+	wheel.Advance(START + milliseconds(3000), expired);
+	ASSERT_EQ(1u, expired.size());
+	EXPECT_EQ(7, expired[0]);
+	EXPECT_FALSE(wheel.IsScheduled(7));
+	EXPECT_EQ(0, wheel.GetNumScheduled());
+	EXPECT_TRUE(Clock::time_point::max() == wheel.GetNextDeadline());
+}
+
+TEST(TimerWheelTest, testNeverFiresEarly)
+{
+	TimerWheel wheel(START);
+	std::vector<int> expired;
+
+	//rounded up to the next whole tick
+	wheel.Schedule(1, START + std::chrono::microseconds(1500));
+	EXPECT_TRUE(START + milliseconds(2) == wheel.GetNextDeadline());
+	wheel.Advance(START + std::chrono::microseconds(1999), expired);
+	EXPECT_TRUE(expired.empty());
+	wheel.Advance(START + milliseconds(2), expired);
+	EXPECT_EQ(1u, expired.size());
+}
+
+TEST(TimerWheelTest, testCancelAndReschedule)
+{
+	TimerWheel wheel(START);
+	std::vector<int> expired;
+
+	wheel.Schedule(1, START + milliseconds(100));
+	wheel.Schedule(2, START + milliseconds(200));
+	EXPECT_TRUE(wheel.Cancel(1));
+	EXPECT_FALSE(wheel.Cancel(1));
+	EXPECT_FALSE(wheel.IsScheduled(1));
+
+	//moving a timer replaces its old deadline
+	wheel.Schedule(2, START + milliseconds(50));
+	EXPECT_EQ(1, wheel.GetNumScheduled());
+	wheel.Advance(START + milliseconds(60), expired);
+	ASSERT_EQ(1u, expired.size());
+	EXPECT_EQ(2, expired[0]);
+
+	expired.clear();
+	wheel.Advance(START + milliseconds(1000), expired);
+	EXPECT_TRUE(expired.empty());
+}
+
+TEST(TimerWheelTest, testOverdueFiresOnNextAdvance)
+{
+	TimerWheel wheel(START);
+	std::vector<int> expired;
+
+	wheel.Advance(START + milliseconds(500), expired);
+	wheel.Schedule(3, START + milliseconds(400));
+	wheel.Schedule(4, START + milliseconds(100));
+	EXPECT_TRUE(START + milliseconds(100) == wheel.GetNextDeadline());
+
+	wheel.Advance(START + milliseconds(500), expired);
+	ASSERT_EQ(2u, expired.size());
+	EXPECT_EQ(4, expired[0]);
+	EXPECT_EQ(3, expired[1]);
+}
+
+TEST(TimerWheelTest, testPastTheTopLevel)
+{
+	//a long tick so the top level runs out quickly
+	TimerWheel wheel(START, std::chrono::seconds(1));
+	const auto wheelSpan = std::chrono::seconds(1) * (1ll << (TimerWheel::SLOT_BITS * TimerWheel::NUM_LEVELS));
+	std::vector<int> expired;
+
+	wheel.Schedule(1, START + 3 * wheelSpan + std::chrono::seconds(5));
+	wheel.Schedule(2, Clock::time_point::max());
+	EXPECT_TRUE(START + 3 * wheelSpan + std::chrono::seconds(5) == wheel.GetNextDeadline());
+
+	wheel.Advance(START + 3 * wheelSpan + std::chrono::seconds(4), expired);
+	EXPECT_TRUE(expired.empty());
+	wheel.Advance(START + 3 * wheelSpan + std::chrono::seconds(5), expired);
+	ASSERT_EQ(1u, expired.size());
+	EXPECT_EQ(1, expired[0]);
+	EXPECT_TRUE(Clock::time_point::max() == wheel.GetNextDeadline());
+}
+
+TEST(TimerWheelTest, testMatchesSortedDeadlines)
+{
+	//random schedules, cancels and advances against a plain map of deadlines
+	std::mt19937 rng(11);
+	TimerWheel wheel(START);
+	std::map<int, Clock::time_point> deadlines;
+	auto now = START;
+	std::vector<int> expired;
+
+	for (int step = 0; step < 20000; ++step)
+	{
+		const int action = rng() % 10;
+		const int timerID = rng() % 500;
+		if (action < 5)
+		{
+			//mostly short waits, some long enough to reach the upper levels
+			const auto wait = (rng() % 4 == 0) ? milliseconds(rng() % 20000000) : milliseconds(rng() % 5000);
+			wheel.Schedule(timerID, now + wait);
+			deadlines[timerID] = now + wait;
+		}
+		else if (action < 6)
+		{
+			EXPECT_EQ(deadlines.erase(timerID) > 0, wheel.Cancel(timerID));
+		}
+		else
+		{
+			now += (rng() % 50 == 0) ? milliseconds(rng() % 5000000) : milliseconds(rng() % 300);
+			expired.clear();
+			wheel.Advance(now, expired);
+
+			std::vector<std::pair<Clock::time_point, int>> expected;
+			for (const auto& timer : deadlines)
+			{
+				if (timer.second <= now)
+					expected.emplace_back(timer.second, timer.first);
+			}
+			ASSERT_EQ(expected.size(), expired.size());
+
+			//deadlines come out in order, whatever order ties are in
+			std::sort(expected.begin(), expected.end());
+			for (size_t i = 0; i < expired.size(); ++i)
+			{
+				EXPECT_TRUE(deadlines.at(expired[i]) == expected[i].first);
+				deadlines.erase(expired[i]);
+			}
+		}
+
+		ASSERT_EQ(static_cast<int>(deadlines.size()), wheel.GetNumScheduled());
+		auto nextDeadline = Clock::time_point::max();
+		for (const auto& timer : deadlines)
+			nextDeadline = std::min(nextDeadline, timer.second);
+		EXPECT_TRUE(nextDeadline == wheel.GetNextDeadline());
+	}
+}
+
+TEST(TimerWheelTest, testRestoreIntoOtherWheel)
+{
+	TimerWheel wheel(START);
+	wheel.Schedule(3, START + milliseconds(2500));
+
+	GameSnapshot snapshot;
+	{
+		SnapshotWriter writer(snapshot);
+		wheel.SaveState(writer);
+	}
+
+	//started later and ticking slower, it takes on the saved wheel's times
+	TimerWheel other(START + milliseconds(700), milliseconds(10));
+	SnapshotReader reader(snapshot);
+	other.LoadState(reader);
+	EXPECT_TRUE(reader.IsAtEnd());
+	EXPECT_TRUE(wheel.GetTickLength() == other.GetTickLength());
+	EXPECT_TRUE(START + milliseconds(2500) == other.GetNextDeadline());
+
+	std::vector<int> expired;
+	other.Advance(START + milliseconds(2499), expired);
+	EXPECT_TRUE(expired.empty());
+	other.Advance(START + milliseconds(2500), expired);
+	ASSERT_EQ(1u, expired.size());
+	EXPECT_EQ(3, expired[0]);
+}
+
+TEST(TimerWheelTest, DISABLED_benchmarkAdvance)
+{
+	//a 60 fps loop over 10 minutes with every timer running a 3 second harvest,
+	// restarted as soon as it finishes
+	for (int numTimers : { 6, 1000, 100000 })
+	{
+		TimerWheel wheel(START);
+		std::mt19937 rng(5);
+		for (int timerID = 0; timerID < numTimers; ++timerID)
+			wheel.Schedule(timerID, START + milliseconds(rng() % 3000));
+
+		const int numFrames = 60 * 60 * 10;
+		std::vector<int> expired;
+		long long numExpired = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (int frame = 1; frame <= numFrames; ++frame)
+		{
+			const auto now = START + milliseconds(frame * 1000 / 60);
+			expired.clear();
+			wheel.Advance(now, expired);
+			for (auto timerID : expired)
+				wheel.Schedule(timerID, now + std::chrono::seconds(3));
+			numExpired += expired.size();
+		}
+		const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+		std::cout << numTimers << " timers: " << elapsed.count() / numFrames << " us per frame, "
+			<< numExpired << " expired" << std::endl;
+	}
+}